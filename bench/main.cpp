@@ -0,0 +1,166 @@
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../src/ioadapter.hpp"
+
+
+using namespace planner;
+
+namespace {
+    struct Variant {
+        std::string name;
+        std::function<std::shared_ptr<Search>(const Search&)> make;
+        std::size_t cell_limit = 0;  // maps with more cells are skipped, 0 means no limit
+    };
+
+    /// path database precomputation is quadratic in the number of free cells
+    constexpr std::size_t path_database_cell_limit = 128 * 128;
+
+    std::set<std::string> split_names(const std::string& list) {
+        std::set<std::string> names;
+        std::istringstream stream{ list };
+        for (std::string name; std::getline(stream, name, ',');) {
+            if (!name.empty()) {
+                names.insert(name);
+            }
+        }
+        return names;
+    }
+
+    void print_row(const std::string& filename, const std::string& variant) {
+        std::cout << std::left << std::setw(40) << filename << std::setw(24) << variant << std::right;
+    }
+
+    std::shared_ptr<Search> with_open_list(const Search& search, OpenListType type) {
+        auto options = search.get_options();
+        options.open_list = type;
+        return std::make_shared<AStar>(search.get_heuristic(), search.get_tie_breaker(), options);
+    }
+
+    std::vector<Variant> variants() {
+        return {
+            { "astar/set", [](const Search& search) { return with_open_list(search, OpenListType::set); } },
+            { "astar/binary-heap", [](const Search& search) { return with_open_list(search, OpenListType::binary_heap); } },
+            { "astar/heap", [](const Search& search) { return with_open_list(search, OpenListType::quaternary_heap); } },
+            // needs a whole heuristic weight and a heuristic with exact values, otherwise reported as unsupported
+            { "astar/exact", [](const Search& search) {
+                auto options = search.get_options();
+                options.exact_distances = true;
+                return std::make_shared<AStar>(search.get_heuristic(), search.get_tie_breaker(), options);
+            } },
+            { "bidirectional_astar", [](const Search& search) {
+                return std::make_shared<BidirectionalAStar>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "bucket_astar", [](const Search& search) {
+                return std::make_shared<BucketAStar>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "bfs", [](const Search& search) {
+                return std::make_shared<BreadthFirst>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "cpd", [](const Search& search) {
+                return std::make_shared<PathDatabaseSearch>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            }, path_database_cell_limit },
+            { "fringe", [](const Search& search) {
+                return std::make_shared<FringeSearch>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "hpa", [](const Search& search) {
+                return std::make_shared<HPAStar>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "jp_search", [](const Search& search) {
+                return std::make_shared<JumpPoint>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "jp_search_plus", [](const Search& search) {
+                return std::make_shared<JumpPointPlus>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "subgoal", [](const Search& search) {
+                return std::make_shared<SubgoalGraphSearch>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "theta", [](const Search& search) {
+                return std::make_shared<ThetaStar>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+            { "lazy_theta", [](const Search& search) {
+                return std::make_shared<LazyThetaStar>(search.get_heuristic(), search.get_tie_breaker(), search.get_options());
+            } },
+        };
+    }
+}
+
+/// usage: benchmark [-r repetitions] [-v variant,...] input.xml...
+/// runs the selected benchmark variants (all by default) on every input document and prints mean search time
+int main(int argc, char** argv) {
+    std::size_t repetitions = 5;
+    std::set<std::string> selected;
+    std::vector<std::string> filenames;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument{ argv[i] };
+        if (argument == "-r" && i + 1 < argc) {
+            repetitions = std::stoull(argv[++i]);
+        } else if (argument == "-v" && i + 1 < argc) {
+            selected = split_names(argv[++i]);
+        } else {
+            filenames.push_back(argument);
+        }
+    }
+    if (filenames.empty() || repetitions == 0) {
+        std::cerr << "usage: " << argv[0] << " [-r repetitions] [-v variant,...] input.xml..." << std::endl;
+        return 1;
+    }
+    for (const auto& name : selected) {
+        bool known = false;
+        for (const auto& variant : variants()) {
+            known = known || variant.name == name;
+        }
+        if (!known) {
+            std::cerr << "unknown variant: " << name << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::left << std::setw(40) << "input" << std::setw(24) << "variant"
+              << std::right << std::setw(12) << "steps" << std::setw(14) << "length" << std::setw(14) << "mean, ms" << '\n';
+    for (const auto& filename : filenames) {
+        IOAdapter adapter{ filename };
+        auto map = adapter.read_map();
+        auto locations = adapter.read_locations();
+        auto search = adapter.read_algorithm(map);
+        for (const auto& variant : variants()) {
+            if (!selected.empty() && selected.count(variant.name) == 0) {
+                continue;
+            }
+            std::size_t cells = map.get_width() * map.get_height();
+            if (variant.cell_limit != 0 && cells > variant.cell_limit) {
+                print_row(filename, variant.name);
+                std::cout << "skipped: " << cells << " cells, limit is " << variant.cell_limit << '\n';
+                continue;
+            }
+            std::shared_ptr<Search> instance;
+            try {
+                instance = variant.make(*search);
+            } catch (const std::logic_error& error) {
+                print_row(filename, variant.name);
+                std::cout << "unsupported: " << error.what() << '\n';
+                continue;
+            }
+            std::chrono::high_resolution_clock::duration total{};
+            SearchState result;
+            for (std::size_t repetition = 0; repetition < repetitions; ++repetition) {
+                result = instance->search(locations.first, locations.second, map);
+                total += result.time_spent;
+            }
+            double mean = std::chrono::duration_cast<std::chrono::nanoseconds>(total).count() / 1e6 / static_cast<double>(repetitions);
+            print_row(filename, variant.name);
+            std::cout << std::setw(12) << result.closed_indices.size()
+                      << std::setw(14) << std::fixed << std::setprecision(5) << result.path_length()
+                      << std::setw(14) << std::setprecision(3) << mean << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "batch.hpp"
+
+
+namespace planner {
+    namespace {
+        // small enough to balance queries of very different cost, large enough to keep the counter cold
+        constexpr std::size_t chunks_per_thread = 16;
+    }
+
+    double BatchResult::queries_per_second() const {
+        double seconds = std::chrono::duration_cast<std::chrono::nanoseconds>(time_spent).count() / 1e9;
+        return seconds > 0 ? results.size() / seconds : 0;
+    }
+
+    BatchResult run_batch(const Search& search, const GridMap<CellType>& map, const std::vector<Query>& queries, std::size_t thread_count) {
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::max<std::size_t>(1, std::min(thread_count, queries.size()));
+        auto start_time = std::chrono::high_resolution_clock::now();
+        BatchResult batch;
+        batch.results.resize(queries.size());
+        batch.thread_count = thread_count;
+
+        std::size_t chunk_size = std::max<std::size_t>(1, queries.size() / (thread_count * chunks_per_thread));
+        std::atomic<std::size_t> next_chunk{ 0 };
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            SearchContext context;
+            try {
+                while (true) {
+                    std::size_t begin = next_chunk.fetch_add(chunk_size, std::memory_order_relaxed);
+                    if (begin >= queries.size()) {
+                        break;
+                    }
+                    std::size_t end = std::min(begin + chunk_size, queries.size());
+                    for (std::size_t i = begin; i < end; ++i) {
+                        const SearchState& state = search.search(queries[i].from, queries[i].to, map, context);
+                        batch.results[i] = { state.path_found, state.path_length(), state.closed_indices.size(), state.time_spent };
+                    }
+                }
+            } catch (...) {
+                std::lock_guard lock{ error_mutex };
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next_chunk.store(queries.size(), std::memory_order_relaxed);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count - 1);
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        batch.time_spent = std::chrono::high_resolution_clock::now() - start_time;
+        return batch;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "map.hpp"
+#include "search/search.hpp"
+
+
+namespace planner {
+    struct Query {
+        Point from;
+        Point to;
+    };
+
+    /// Compact result of a single query, the path itself is dropped
+    struct QueryResult {
+        bool path_found = false;
+        double length = 0;
+        std::size_t steps = 0;
+        std::chrono::high_resolution_clock::duration time_spent{};
+    };
+
+    struct BatchResult {
+        std::vector<QueryResult> results;  // in the order of queries
+        std::chrono::high_resolution_clock::duration time_spent{};  // wall time of the whole batch
+        std::size_t thread_count = 1;
+
+        [[nodiscard]] double queries_per_second() const;
+    };
+
+    /// Runs all queries on one map with `thread_count` workers, 0 means one worker per hardware thread
+    /// workers take chunks of consecutive queries from a shared counter, every worker reuses its own search memory
+    [[nodiscard]] BatchResult run_batch(const Search& search, const GridMap<CellType>& map, const std::vector<Query>& queries, std::size_t thread_count = 1);
+}
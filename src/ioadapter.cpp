@@ -1,4 +1,6 @@
+#include <chrono>
 #include <cstddef>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -11,7 +13,7 @@
 
 
 namespace planner {
-    IOAdapter::IOAdapter(const std::string &filename) {
+    IOAdapter::IOAdapter(const std::string &filename) : directory(std::filesystem::path{ filename }.parent_path().string()) {
         std::ifstream input{filename};
         document.load(input);
         input.close();
@@ -71,6 +73,70 @@ namespace planner {
         return { start, finish };
     }
 
+    /// returns why the query can't be searched on the map, or an empty string
+    std::string query_error(const Query& query, const GridMap<CellType>& map) {
+        for (const Point& point : { query.from, query.to }) {
+            std::stringstream error;
+            if (point.x >= map.get_width() || point.y >= map.get_height()) {
+                error << point << " is outside of the map";
+                return error.str();
+            }
+            if (map(point.x, point.y) == CellType::obstacle) {
+                error << point << " is an obstacle";
+                return error.str();
+            }
+        }
+        return {};
+    }
+
+    std::vector<Query> read_scenario(std::istream& input, const GridMap<CellType>& map) {
+        std::vector<Query> queries;
+        std::string line;
+        for (size_t line_number = 1; std::getline(input, line); ++line_number) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos || line.rfind("version", 0) == 0) {
+                continue;
+            }
+            std::stringstream fields{ line };
+            std::string bucket, map_name;
+            size_t width, height;
+            Query query{};
+            if (!(fields >> bucket >> map_name >> width >> height >> query.from.x >> query.from.y >> query.to.x >> query.to.y)) {
+                throw std::logic_error{ "malformed scenario line " + std::to_string(line_number) + ": " + line };
+            }
+            if (auto error = query_error(query, map); !error.empty()) {
+                throw std::logic_error{ "scenario line " + std::to_string(line_number) + ": " + error + ": " + line };
+            }
+            queries.push_back(query);
+        }
+        return queries;
+    }
+
+    std::vector<Query> IOAdapter::read_queries(const GridMap<CellType>& map) const {
+        std::vector<Query> queries;
+        auto queries_node = document.child("root").child("queries");
+        if (auto file = queries_node.attribute("file"); file) {
+            auto path = std::filesystem::path{ directory } / file.value();
+            std::ifstream input{ path };
+            if (!input) {
+                throw std::logic_error{ "can't open scenario file: " + path.string() };
+            }
+            queries = read_scenario(input, map);
+        }
+        size_t query_number = 0;
+        for (const auto& query_node : queries_node.children("query")) {
+            Query query{
+                { std::stoull(query_node.attribute("startx").value()), std::stoull(query_node.attribute("starty").value()) },
+                { std::stoull(query_node.attribute("finishx").value()), std::stoull(query_node.attribute("finishy").value()) },
+            };
+            ++query_number;
+            if (auto error = query_error(query, map); !error.empty()) {
+                throw std::logic_error{ "query " + std::to_string(query_number) + ": " + error };
+            }
+            queries.push_back(query);
+        }
+        return queries;
+    }
+
     std::shared_ptr<Heuristic<Point>> parse_metric(const std::string& text) {
         if (text == "diagonal") {
             return std::make_unique<Diagonal<Point>>();
@@ -93,11 +159,22 @@ namespace planner {
         throw std::logic_error{ "unknown tie breaker: " + text };
     }
 
+    OpenListType parse_open_list(const std::string& text) {
+        if (text == "heap") {
+            return OpenListType::quaternary_heap;
+        } else if (text == "binary-heap") {
+            return OpenListType::binary_heap;
+        } else if (text == "set") {
+            return OpenListType::set;
+        }
+        throw std::logic_error{ "unknown open list type: " + text };
+    }
+
     bool parse_bool_value(const std::string& text) {
         return !(text == "false" || text == "False" || text == "0" || text == "0.0");
     }
 
-    std::shared_ptr<Search> IOAdapter::read_algorithm() const {
+    std::shared_ptr<Search> IOAdapter::read_algorithm(const GridMap<CellType>& map) const {
         auto algorithm_node = document.child("root").child("algorithm");
         auto heuristic = parse_metric(extract_value_with_default(algorithm_node, "metrictype", "euclidean"));
         auto tie_breaker = parse_tie_breaker(extract_value_with_default(algorithm_node, "breakingties", "g-max"));
@@ -106,46 +183,82 @@ namespace planner {
             parse_bool_value(extract_value_with_default(algorithm_node, "allowdiagonal", "true")),
             parse_bool_value(extract_value_with_default(algorithm_node, "cutcorners", "true")),
             parse_bool_value(extract_value_with_default(algorithm_node, "allowsqueeze", "true")),
+            parse_open_list(extract_value_with_default(algorithm_node, "openlist", "heap")),
+            parse_bool_value(extract_value_with_default(algorithm_node, "exactdistances", "false")),
+            parse_bool_value(extract_value_with_default(algorithm_node, "goalbounding", "false")),
         };
+        auto landmark_count = static_cast<size_t>(std::stoull(extract_value_with_default(algorithm_node, "landmarks", "0")));
+        if (landmark_count > 0) {
+            MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+            auto table = std::make_shared<const LandmarkTable>(map, rules, landmark_count);
+            heuristic = std::make_shared<LandmarkHeuristic<Point>>(std::move(table), std::move(heuristic));
+        }
         std::string search_type = algorithm_node.child_value("searchtype");
         if (search_type == "astar") {
-            return std::make_unique<AStar>(std::move(heuristic), std::move(tie_breaker), options);
+            return std::make_unique<AStar>(std::move(heuristic), std::move(tie_breaker), options, extract_value_with_default(algorithm_node, "cachedir", ""));
         } else if (search_type == "dijkstra") {
             options.heuristic_weight = 0;
-            return std::make_unique<AStar>(std::move(heuristic), std::move(tie_breaker), options);
+            return std::make_unique<AStar>(std::move(heuristic), std::move(tie_breaker), options, extract_value_with_default(algorithm_node, "cachedir", ""));
+        } else if (search_type == "arastar") {
+            auto weight_step = std::stod(extract_value_with_default(algorithm_node, "weightstep", "0.5"));
+            auto deadline = std::chrono::duration<double, std::milli>{ std::stod(extract_value_with_default(algorithm_node, "deadline", "0")) };
+            return std::make_unique<AraStar>(std::move(heuristic), std::move(tie_breaker), options, weight_step, std::chrono::duration_cast<std::chrono::microseconds>(deadline));
+        } else if (search_type == "bidirectional_astar") {
+            return std::make_unique<BidirectionalAStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "bidirectional_dijkstra") {
+            options.heuristic_weight = 0;
+            return std::make_unique<BidirectionalAStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "fringe") {
+            return std::make_unique<FringeSearch>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "jp_search") {
+            return std::make_unique<JumpPoint>(std::move(heuristic), std::move(tie_breaker), options, extract_value_with_default(algorithm_node, "cachedir", ""));
+        } else if (search_type == "jp_search_plus") {
+            return std::make_unique<JumpPointPlus>(std::move(heuristic), std::move(tie_breaker), options, extract_value_with_default(algorithm_node, "cachedir", ""));
+        } else if (search_type == "theta") {
+            return std::make_unique<ThetaStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "lazy_theta") {
+            return std::make_unique<LazyThetaStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "hpa") {
+            auto cluster_size = static_cast<size_t>(std::stoull(extract_value_with_default(algorithm_node, "clustersize", "16")));
+            return std::make_unique<HPAStar>(std::move(heuristic), std::move(tie_breaker), options, cluster_size);
+        } else if (search_type == "bucket_astar") {
+            return std::make_unique<BucketAStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "bucket_dijkstra") {
+            options.heuristic_weight = 0;
+            return std::make_unique<BucketAStar>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "cpd") {
+            return std::make_unique<PathDatabaseSearch>(std::move(heuristic), std::move(tie_breaker), options, extract_value_with_default(algorithm_node, "cachedir", ""));
+        } else if (search_type == "subgoal") {
+            return std::make_unique<SubgoalGraphSearch>(std::move(heuristic), std::move(tie_breaker), options);
+        } else if (search_type == "bfs") {
+            return std::make_unique<BreadthFirst>(std::move(heuristic), std::move(tie_breaker), options);
         }
-//        if (search_type == "bfs") {
-//            return std::make_unique<BreadthFirst>(std::move(heuristic), std::move(tie_breaker), options);
-//        } else if (search_type == "jp_search") {
-//            return std::make_unique<JumpPoint>(std::move(heuristic), std::move(tie_breaker), options);
-//        } else if (search_type == "theta") {
-//            return std::make_unique<ThetaStar>(std::move(heuristic), std::move(tie_breaker), options);
-//        }
         throw std::logic_error{ "unknown search type: " + search_type };
     }
 
-    void write_node(pugi::xml_node& parent_node, const std::shared_ptr<Node>& node) {
+    void write_node(pugi::xml_node& parent_node, const Node& node, const NodeArena& nodes) {
         auto child_node = parent_node.append_child("node");
-        child_node.append_attribute("x").set_value(node->position.x);
-        child_node.append_attribute("y").set_value(node->position.y);
-        child_node.append_attribute("F").set_value(node->distance + node->estimation);
-        child_node.append_attribute("g").set_value(node->distance);
-        if (node->expanded_from != nullptr) {
-            child_node.append_attribute("parent_x").set_value(node->expanded_from->position.x);
-            child_node.append_attribute("parent_y").set_value(node->expanded_from->position.y);
+        child_node.append_attribute("x").set_value(node.position.x);
+        child_node.append_attribute("y").set_value(node.position.y);
+        child_node.append_attribute("F").set_value(node.distance + node.estimation);
+        child_node.append_attribute("g").set_value(node.distance);
+        if (node.parent != Node::none) {
+            child_node.append_attribute("parent_x").set_value(nodes[node.parent].position.x);
+            child_node.append_attribute("parent_y").set_value(nodes[node.parent].position.y);
         }
     }
 
-    void write_step(pugi::xml_node& lowlevel_node, size_t step, const std::list<std::shared_ptr<Node>>& open, const std::list<std::shared_ptr<Node>>& closed) {
+    template <typename OpenNodes>
+    void write_step(pugi::xml_node& lowlevel_node, size_t step, const OpenNodes& open, const NodeView& closed, const NodeArena& nodes) {
         auto step_node = lowlevel_node.append_child("step");
         step_node.append_attribute("number").set_value(step);
         auto open_node = step_node.append_child("open");
         for (const auto& node : open) {
-            write_node(open_node, node);
+            write_node(open_node, node, nodes);
         }
         auto close_node = step_node.append_child("close");
         for (const auto& node : closed) {
-            write_node(close_node, node);
+            write_node(close_node, node, nodes);
         }
     }
 
@@ -160,18 +273,21 @@ namespace planner {
 
         auto summary_node = log_node.append_child("summary");
         if (log_options.is_level_at_least_tiny()) {
-            summary_node.append_attribute("numberofsteps") = result.closed.size();
-            summary_node.append_attribute("nodescreated") = result.closed.size() + result.open.size();
+            summary_node.append_attribute("numberofsteps") = result.closed_indices.size();
+            summary_node.append_attribute("nodescreated") = result.closed_indices.size() + result.open_indices.size();
             summary_node.append_attribute("length") = result.path_length();
             summary_node.append_attribute("length_scaled") = result.path_length() * map.get_cell_size();
             summary_node.append_attribute("time") = std::chrono::duration_cast<std::chrono::nanoseconds>(result.time_spent).count() / 1e9;
+            for (const auto& [name, value] : result.statistics) {
+                summary_node.append_attribute(name.c_str()) = value;
+            }
         }
 
         if (log_options.is_level_at_least_short() && map.get_width() != 0 && map.get_height() != 0) {
             auto path_node = log_node.append_child("path");
             std::unordered_set<Point> path_points;
-            for (const auto& ptr : result.path) {
-                path_points.insert(ptr->position);
+            for (const auto& node : result.path()) {
+                path_points.insert(node.position);
             }
             for (size_t y = 0; y < map.get_height(); ++y) {
                 auto row_node = path_node.append_child("row");
@@ -196,39 +312,40 @@ namespace planner {
         auto lplevel = log_node.append_child("lplevel");
         if (log_options.is_level_at_least_short()) {
             size_t number = 0;
-            for (const auto& path_node : result.path) {
+            for (const auto& path_node : result.path()) {
                 auto node = lplevel.append_child("node");
-                node.append_attribute("x").set_value(path_node->position.x);
-                node.append_attribute("y").set_value(path_node->position.y);
+                node.append_attribute("x").set_value(path_node.position.x);
+                node.append_attribute("y").set_value(path_node.position.y);
                 node.append_attribute("number").set_value(number);
                 ++number;
             }
         }
         auto hplevel = log_node.append_child("hplevel");
         if (log_options.is_level_at_least_short()) {
-            if (result.path.size() == 1) {
-                const auto& path_node = result.path.front();
+            auto path = result.path();
+            if (path.size() == 1) {
+                const auto& path_node = path.front();
                 pugi::xml_node section = hplevel.append_child("section");
                 section.append_attribute("number").set_value(0);
-                section.append_attribute("start.x").set_value(path_node->position.x);
-                section.append_attribute("start.y").set_value(path_node->position.y);
-                section.append_attribute("finish.x").set_value(path_node->position.x);
-                section.append_attribute("finish.y").set_value(path_node->position.y);
+                section.append_attribute("start.x").set_value(path_node.position.x);
+                section.append_attribute("start.y").set_value(path_node.position.y);
+                section.append_attribute("finish.x").set_value(path_node.position.x);
+                section.append_attribute("finish.y").set_value(path_node.position.y);
                 section.append_attribute("length").set_value(0);
-            } else if (result.path.size() > 1) {
+            } else if (path.size() > 1) {
                 size_t section_number = 0;
-                auto prev_path_node = result.path.front();
+                const Node* prev_path_node = &path.front();
                 pugi::xml_node section = hplevel.append_child("section");
                 section.append_attribute("number").set_value(section_number);
                 section.append_attribute("start.x").set_value(prev_path_node->position.x);
                 section.append_attribute("start.y").set_value(prev_path_node->position.y);
-                auto cit = std::next(std::begin(result.path));
-                int dx = static_cast<int>((*cit)->position.x - prev_path_node->position.x);
-                int dy = static_cast<int>((*cit)->position.y - prev_path_node->position.y);
+                auto cit = std::next(std::begin(path));
+                int dx = static_cast<int>(cit->position.x - prev_path_node->position.x);
+                int dy = static_cast<int>(cit->position.y - prev_path_node->position.y);
                 double current_path_length = 0.0;
-                for (; cit != std::end(result.path); ++cit) {
-                    int current_dx = static_cast<int>((*cit)->position.x - prev_path_node->position.x);
-                    int current_dy = static_cast<int>((*cit)->position.y - prev_path_node->position.y);
+                for (; cit != std::end(path); ++cit) {
+                    int current_dx = static_cast<int>(cit->position.x - prev_path_node->position.x);
+                    int current_dy = static_cast<int>(cit->position.y - prev_path_node->position.y);
                     if (current_dx == dx && current_dy == dy) {
                         current_path_length += std::sqrt(dx * dx + dy * dy);
                     } else {
@@ -244,7 +361,7 @@ namespace planner {
                         dy = current_dy;
                         current_path_length = std::sqrt(dx * dx + dy * dy);
                     }
-                    prev_path_node = *cit;
+                    prev_path_node = &*cit;
                 }
                 section.append_attribute("finish.x").set_value(prev_path_node->position.x);
                 section.append_attribute("finish.y").set_value(prev_path_node->position.y);
@@ -255,15 +372,54 @@ namespace planner {
         size_t step_counter = 0;
         auto lowlevel = log_node.append_child("lowlevel");
         if (log_options.is_level_at_least_full()) {
-            for (auto it_open = result.open_history.begin(), it_closed = result.closed_history.begin();
-                it_open != result.open_history.end() && it_closed != result.closed_history.end();
-                ++it_open, ++it_closed, ++step_counter) {
-                write_step(lowlevel, step_counter, *it_open, *it_closed);
+            for (; step_counter < result.open_history.size() && step_counter < result.closed_history.size(); ++step_counter) {
+                NodeView closed{ result.nodes, result.closed_indices, result.closed_history[step_counter] };
+                write_step(lowlevel, step_counter, result.open_history[step_counter], closed, result.nodes);
             }
         }
 
         if (log_options.is_level_at_least_medium()) {
-            write_step(lowlevel, step_counter, result.open, result.closed);
+            write_step(lowlevel, step_counter, result.open(), result.closed(), result.nodes);
+        }
+    }
+
+    void IOAdapter::write_batch_result(const BatchResult& batch, const std::vector<Query>& queries, const std::string& input_filename, const LogOptions& log_options) {
+        auto root_node = document.child("root");
+        while (root_node.find_node([](const pugi::xml_node& p) { return std::string{ p.name() } == "log"; })) {
+            root_node.remove_child("log");
+        }
+        auto log_node = root_node.append_child("log");
+
+        log_node.append_child("mapfilename").append_child(pugi::node_pcdata).set_value(input_filename.data());
+
+        auto summary_node = log_node.append_child("summary");
+        if (log_options.is_level_at_least_tiny()) {
+            size_t paths_found = 0;
+            for (const auto& result : batch.results) {
+                paths_found += result.path_found;
+            }
+            summary_node.append_attribute("queries") = batch.results.size();
+            summary_node.append_attribute("pathsfound") = paths_found;
+            summary_node.append_attribute("time") = std::chrono::duration_cast<std::chrono::nanoseconds>(batch.time_spent).count() / 1e9;
+            summary_node.append_attribute("threads") = batch.thread_count;
+            summary_node.append_attribute("queriespersecond") = batch.queries_per_second();
+        }
+
+        if (log_options.is_level_at_least_short()) {
+            auto results_node = log_node.append_child("results");
+            for (size_t i = 0; i < batch.results.size(); ++i) {
+                const auto& result = batch.results[i];
+                auto result_node = results_node.append_child("result");
+                result_node.append_attribute("number") = i;
+                result_node.append_attribute("startx") = queries[i].from.x;
+                result_node.append_attribute("starty") = queries[i].from.y;
+                result_node.append_attribute("finishx") = queries[i].to.x;
+                result_node.append_attribute("finishy") = queries[i].to.y;
+                result_node.append_attribute("found") = result.path_found;
+                result_node.append_attribute("length") = result.length;
+                result_node.append_attribute("numberofsteps") = result.steps;
+                result_node.append_attribute("time") = std::chrono::duration_cast<std::chrono::nanoseconds>(result.time_spent).count() / 1e9;
+            }
         }
     }
 
@@ -280,4 +436,9 @@ namespace planner {
         log_options.log_filename = extract_value_with_default(options_node, "logfilename", "");
         return log_options;
     }
+
+    std::size_t IOAdapter::read_thread_count() const {
+        auto options_node = document.child("root").child("options");
+        return static_cast<size_t>(std::stoull(extract_value_with_default(options_node, "threads", "1")));
+    }
 }
@@ -1,7 +1,11 @@
 #pragma once
+#include <istream>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 #include "pugixml.hpp"
+#include "batch.hpp"
 #include "map.hpp"
 #include "search/search.hpp"
 
@@ -9,8 +13,10 @@
 namespace planner {
     class IOAdapter {
         pugi::xml_document document;
+        std::string directory;  // of the input file, files named by the document are relative to it
     public:
         IOAdapter(const std::string& filename);
+        /// files named by the document are relative to the working directory
         IOAdapter(std::istream& stream);
 
         void save_document(const std::string& filename) const;
@@ -18,10 +24,22 @@ namespace planner {
 
         [[nodiscard]] GridMap<CellType> read_map() const;
         [[nodiscard]] std::pair<Point, Point> read_locations() const;
-        [[nodiscard]] std::shared_ptr<Search> read_algorithm() const;
+        /// queries of the batch mode, listed in `queries` node and in the scenario file given by its `file` attribute,
+        /// queries with an end outside of `map` or on an obstacle are rejected
+        [[nodiscard]] std::vector<Query> read_queries(const GridMap<CellType>& map) const;
+        /// the landmark table of the heuristic, if `landmarks` are given, is built for `map`, so the search must run on it
+        [[nodiscard]] std::shared_ptr<Search> read_algorithm(const GridMap<CellType>& map) const;
         [[nodiscard]] double read_path_length() const;  // todo: replace this with reading full log node
         [[nodiscard]] LogOptions read_log_options() const;
+        /// number of batch mode workers, 0 means one per hardware thread
+        [[nodiscard]] std::size_t read_thread_count() const;
 
         void write_result(const SearchState& result, std::string input_filename, const GridMap<CellType>& map, const LogOptions& log_options);  // todo: remove map parameter
+        void write_batch_result(const BatchResult& batch, const std::vector<Query>& queries, const std::string& input_filename, const LogOptions& log_options);
     };
+
+    /// Reads queries of a MovingAI scenario file: a version line and lines of
+    /// `bucket map width height start_x start_y goal_x goal_y optimal_length`,
+    /// a line with an end outside of `map` or on an obstacle is rejected
+    [[nodiscard]] std::vector<Query> read_scenario(std::istream& input, const GridMap<CellType>& map);
 }
@@ -9,11 +9,16 @@ using namespace planner;
 int main(int argc, char** argv) {
     IOAdapter adapter = argc < 2 ? IOAdapter{ std::cin } : IOAdapter{ argv[1] };
     auto map = adapter.read_map();
-    auto locations = adapter.read_locations();
-    auto search = adapter.read_algorithm();
+    auto search = adapter.read_algorithm(map);
     auto log_options = adapter.read_log_options();
-    auto result = search->search(locations.first, locations.second, map, log_options.is_level_at_least_full());
-    adapter.write_result(result, argc < 2 ? "123" : std::string{ argv[1] }, map, log_options);
+    if (auto queries = adapter.read_queries(map); !queries.empty()) {
+        auto batch = run_batch(*search, map, queries, adapter.read_thread_count());
+        adapter.write_batch_result(batch, queries, argc < 2 ? "123" : std::string{ argv[1] }, log_options);
+    } else {
+        auto locations = adapter.read_locations();
+        auto result = search->search(locations.first, locations.second, map, log_options.is_level_at_least_full());
+        adapter.write_result(result, argc < 2 ? "123" : std::string{ argv[1] }, map, log_options);
+    }
     if (argc < 2) {
         adapter.save_document(std::cout);
     } else {
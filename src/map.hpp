@@ -1,9 +1,12 @@
 #pragma once
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 
@@ -38,40 +41,87 @@ namespace planner {
 
     std::ostream& operator << (std::ostream& out, Point point);
 
+    struct Direction {
+        int dx;
+        int dy;
+    };
+
+    /// Neighbour directions, bit `i` of a neighbourhood mask refers to `directions[i]`
+    /// diagonal directions have even indices, the two straight directions next to a diagonal one are its components
+    inline constexpr std::array<Direction, 8> directions = {{
+        { -1, -1 },
+        { -1, 0 },
+        { -1, 1 },
+        { 0, 1 },
+        { 1, 1 },
+        { 1, 0 },
+        { 1, -1 },
+        { 0, -1 },
+    }};
+
+    /// process wide unique map revision numbers
+    inline std::uint64_t next_map_revision() {
+        static std::atomic<std::uint64_t> counter{ 0 };
+        return ++counter;
+    }
+
     template <typename CellType = planner::CellType>
     class GridMap {
     public:
         using size_type = typename std::vector<CellType>::size_type;
         using difference_type = typename std::vector<CellType>::difference_type;
         using value_type = typename std::vector<CellType>::value_type;
-        using reference = typename std::vector<CellType>::reference;
+        // cells are read only through iterators, `set_cell` and `set_cells` keep neighbourhoods and the revision up to date
+        using reference = typename std::vector<CellType>::const_reference;
         using const_reference = typename std::vector<CellType>::const_reference;
-        using pointer = typename std::vector<CellType>::pointer;
+        using pointer = typename std::vector<CellType>::const_pointer;
         using const_pointer = typename std::vector<CellType>::const_pointer;
-        using iterator = typename std::vector<CellType>::iterator;
+        using iterator = typename std::vector<CellType>::const_iterator;
         using const_iterator = typename std::vector<CellType>::const_iterator;
-        using reverse_iterator = typename std::vector<CellType>::reverse_iterator;
+        using reverse_iterator = typename std::vector<CellType>::const_reverse_iterator;
         using const_reverse_iterator = typename std::vector<CellType>::const_reverse_iterator;
     private:
         size_type width;
         size_type height;
         double cell_size;
         std::vector<value_type> data;
+        std::vector<std::uint8_t> neighbourhoods;
+        std::uint64_t revision;
+
+        void build_neighbourhoods() {
+            neighbourhoods.assign(data.size(), 0);
+            for (size_type y = 0; y < height; ++y) {
+                for (size_type x = 0; x < width; ++x) {
+                    std::uint8_t mask = 0;
+                    for (std::size_t i = 0; i < directions.size(); ++i) {
+                        if (bordered_at(x + directions[i].dx, y + directions[i].dy) != planner::CellType::obstacle) {
+                            mask |= static_cast<std::uint8_t>(1u << i);
+                        }
+                    }
+                    neighbourhoods[y * width + x] = mask;
+                }
+            }
+        }
     public:
         GridMap(size_type width, size_type height, double cell_size, const std::vector<value_type>& data) :
             width(width),
             height(height),
             cell_size(cell_size),
-            data(data)
-        {}
+            data(data),
+            revision(next_map_revision())
+        {
+            build_neighbourhoods();
+        }
 
         template <typename T, typename Mapper>
         GridMap(size_type width, size_type height, double cell_size, const std::vector<T>& data, Mapper mapper = {}) :
                 width(width),
                 height(height),
                 cell_size(cell_size),
-                data(width * height) {
+                data(width * height),
+                revision(next_map_revision()) {
             std::transform(std::begin(data), std::end(data), std::begin(this->data), mapper);
+            build_neighbourhoods();
         }
 
         [[nodiscard]] size_type get_width() const {
@@ -86,6 +136,29 @@ namespace planner {
             return cell_size;
         }
 
+        /// maps with the same revision have the same cells, so data computed for a map can be cached by its revision
+        [[nodiscard]] std::uint64_t get_revision() const {
+            return revision;
+        }
+
+        /// hash of map dimensions and cells, stable across runs
+        [[nodiscard]] std::uint64_t fingerprint() const {
+            std::uint64_t hash = 14695981039346656037ull;
+            auto combine = [&hash](std::uint64_t value) {
+                for (int i = 0; i < 8; ++i) {
+                    hash ^= (value >> (8 * i)) & 0xFFu;
+                    hash *= 1099511628211ull;
+                }
+            };
+            combine(width);
+            combine(height);
+            for (const auto& value : data) {
+                hash ^= static_cast<std::uint64_t>(value);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
         value_type operator ()(size_type x, size_type y) const {
             return data[y * width + x];
         }
@@ -97,18 +170,51 @@ namespace planner {
             return border_value;
         }
 
-        iterator begin() {
-            return data.begin();
+        /// mask of non obstacle neighbours of the cell, cells outside of the map are obstacles
+        [[nodiscard]] std::uint8_t neighbourhood(size_type x, size_type y) const {
+            return neighbourhoods[y * width + x];
+        }
+
+        /// changes the cell and neighbourhoods of the cells around it, the map gets a new revision,
+        /// returns `false` and changes nothing, if the cell already has this value
+        bool set_cell(size_type x, size_type y, value_type value) {
+            if (data[y * width + x] == value) {
+                return false;
+            }
+            bool was_obstacle = data[y * width + x] == planner::CellType::obstacle;
+            data[y * width + x] = value;
+            if (was_obstacle != (value == planner::CellType::obstacle)) {
+                for (std::size_t i = 0; i < directions.size(); ++i) {
+                    size_type neighbour_x = x + directions[i].dx;
+                    size_type neighbour_y = y + directions[i].dy;
+                    if (neighbour_x < width && neighbour_y < height) {
+                        // the neighbour sees this cell in the opposite direction
+                        auto bit = static_cast<std::uint8_t>(1u << ((i + directions.size() / 2) % directions.size()));
+                        neighbourhoods[neighbour_y * width + neighbour_x] ^= bit;
+                    }
+                }
+            }
+            revision = next_map_revision();
+            return true;
+        }
+
+        /// applies `set_cell` to every change, returns positions of the cells which have actually changed
+        std::vector<Point> set_cells(const std::vector<std::pair<Point, value_type>>& changes) {
+            std::vector<Point> changed;
+            for (const auto& [position, value] : changes) {
+                if (set_cell(position.x, position.y, value)) {
+                    changed.push_back(position);
+                }
+            }
+            return changed;
         }
+
         const_iterator begin() const {
             return data.begin();
         }
         const_iterator cbegin() const {
             return data.cbegin();
         }
-        reverse_iterator rbegin() {
-            return data.rbegin();
-        }
         const_reverse_iterator rbegin() const {
             return data.rbegin();
         }
@@ -116,18 +222,12 @@ namespace planner {
             return data.crbegin();
         }
 
-        iterator end() {
-            return data.end();
-        }
         const_iterator end() const {
             return data.end();
         }
         const_iterator cend() const {
             return data.cend();
         }
-        reverse_iterator rend() {
-            return data.rend();
-        }
         const_reverse_iterator rend() const {
             return data.rend();
         }
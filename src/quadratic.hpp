@@ -1,15 +1,16 @@
 #pragma once
 #include <cmath>
 #include <ostream>
+#include <type_traits>
 
 
 namespace planner {
     template <typename T>
     struct Sqrt2 {
         static constexpr T value = static_cast<T>(1.4142135623730950488016887242096980785696718753769480731766797);
+        static constexpr int square = 2;
     };
 
-    // todo: consider removing `Root` parameter, as it'll be unused until multiplication operation is introduced
     template <typename T, typename Root = Sqrt2<double>>
     struct Quadratic {
         T real;
@@ -30,9 +31,20 @@ namespace planner {
             return *this;
         }
 
+        Quadratic& operator *= (Quadratic other) {
+            T result_real = real * other.real + imaginary * other.imaginary * Root::square;
+            imaginary = real * other.imaginary + imaginary * other.real;
+            real = result_real;
+            return *this;
+        }
+
         bool operator == (const Quadratic& other) const {
             return real == other.real && imaginary == other.imaginary;
         }
+
+        bool operator != (const Quadratic& other) const {
+            return !(*this == other);
+        }
     };
 
     template <typename T, typename Root, typename U>
@@ -49,6 +61,55 @@ namespace planner {
         return result;
     }
 
+    template <typename T, typename Root, typename U>
+    Quadratic<T, Root> operator * (Quadratic<T, Root> a, U b) {
+        Quadratic<T, Root> result = a;
+        result *= b;
+        return result;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    using exact_integer = __int128;  // squares of 64 bit components
+#else
+    using exact_integer = long long;
+#endif
+
+    /// sign of `real + imaginary * root` without rounding, components must be integers and `Root::square` must not be a perfect square
+    template <typename T, typename Root>
+    int exact_sign(const Quadratic<T, Root>& quadratic) {
+        static_assert(std::is_integral<T>::value, "exact sign needs integer components");
+        const exact_integer real = quadratic.real, imaginary = quadratic.imaginary;
+        const int real_sign = (real > 0) - (real < 0), imaginary_sign = (imaginary > 0) - (imaginary < 0);
+        if (real_sign == imaginary_sign || imaginary_sign == 0) {
+            return real_sign;
+        }
+        if (real_sign == 0) {
+            return imaginary_sign;
+        }
+        // components have opposite signs, the one with the larger square wins, squares are never equal for an irrational root
+        return real * real > imaginary * imaginary * Root::square ? real_sign : imaginary_sign;
+    }
+
+    template <typename T, typename Root>
+    bool operator < (const Quadratic<T, Root>& a, const Quadratic<T, Root>& b) {
+        return exact_sign(a - b) < 0;
+    }
+
+    template <typename T, typename Root>
+    bool operator > (const Quadratic<T, Root>& a, const Quadratic<T, Root>& b) {
+        return b < a;
+    }
+
+    template <typename T, typename Root>
+    bool operator <= (const Quadratic<T, Root>& a, const Quadratic<T, Root>& b) {
+        return !(b < a);
+    }
+
+    template <typename T, typename Root>
+    bool operator >= (const Quadratic<T, Root>& a, const Quadratic<T, Root>& b) {
+        return !(a < b);
+    }
+
     template <typename T, typename Root>
     std::ostream& operator << (std::ostream& out, const Quadratic<T, Root>& q) {
         return out << '(' << q.real << ", " << q.imaginary << ')';
@@ -61,6 +122,77 @@ namespace planner {
         return quadratic.real + quadratic.imaginary * Root<double>::value;
     }
 
-    // due to euclidean heuristic, it's impossible to utilize `number` in current form
-    // todo: create another class to handle sqrt(number) without actually taking `sqrt`
+    /// `rational + sqrt(radicand)`, a quadratic number plus a euclidean length, which is compared without taking `sqrt`
+    template <typename T, typename Root = Sqrt2<double>>
+    struct RootSum {
+        Quadratic<T, Root> rational;
+        T radicand;
+
+        RootSum() : rational(), radicand() {}
+        RootSum(Quadratic<T, Root> rational, T radicand = {}) : rational(rational), radicand(radicand) {}
+    };
+
+    namespace detail {
+        template <typename Root>
+        using wide = Quadratic<long long, Root>;
+
+        /// sign of `a + b * sqrt(radicand)`
+        template <typename Root>
+        int exact_sign(const wide<Root>& a, const wide<Root>& b, long long radicand) {
+            const int a_sign = planner::exact_sign(a);
+            const int b_sign = radicand == 0 ? 0 : planner::exact_sign(b);
+            if (b_sign == 0 || a_sign == b_sign) {
+                return a_sign;
+            }
+            if (a_sign == 0) {
+                return b_sign;
+            }
+            // opposite signs, compare squares, which are equal, when `sqrt(radicand)` is a multiple of the root
+            const int order = planner::exact_sign(a * a - b * b * wide<Root>{ radicand });
+            return order > 0 ? a_sign : order < 0 ? b_sign : 0;
+        }
+    }
+
+    /// sign of `a - b` without rounding: `x + sqrt(p) - sqrt(q)` is squared twice, so components stay exact integers
+    /// intermediate values are of the order of the fourth power of the components and are squared once more by `exact_sign`,
+    /// which is exact for components up to ~10^4 with 128 bit integers and up to ~100 without them
+    template <typename T, typename Root>
+    int exact_compare(const RootSum<T, Root>& a, const RootSum<T, Root>& b) {
+        static_assert(std::is_integral<T>::value, "exact comparison needs integer components");
+        using wide = detail::wide<Root>;
+        const wide x{ static_cast<long long>(a.rational.real) - b.rational.real, static_cast<long long>(a.rational.imaginary) - b.rational.imaginary };
+        const long long p = a.radicand, q = b.radicand;
+        if (p == q) {
+            return exact_sign(x);
+        }
+        // sign of `x + sqrt(p)` first, `sqrt(q)` is never negative
+        const int left = detail::exact_sign(x, wide{ 1 }, p);
+        if (left <= 0) {
+            return left == 0 && q == 0 ? 0 : -1;
+        }
+        // both sides are positive, so compare squares: `x^2 + p - q + 2x * sqrt(p)` against zero
+        return detail::exact_sign(x * x + wide{ p - q }, x * wide{ 2 }, p);
+    }
+
+    template <typename T, typename Root>
+    bool operator < (const RootSum<T, Root>& a, const RootSum<T, Root>& b) {
+        return exact_compare(a, b) < 0;
+    }
+
+    template <typename T, typename Root>
+    bool operator == (const RootSum<T, Root>& a, const RootSum<T, Root>& b) {
+        return exact_compare(a, b) == 0;
+    }
+
+    template <typename T, template <typename> class Root>
+    double evaluate(const RootSum<T, Root<double>>& sum) {
+        return evaluate(sum.rational) + std::sqrt(static_cast<double>(sum.radicand));
+    }
+
+    template <typename T, typename Root>
+    std::ostream& operator << (std::ostream& out, const RootSum<T, Root>& sum) {
+        return out << sum.rational << " + sqrt(" << sum.radicand << ')';
+    }
+
+    using length = RootSum<int, Sqrt2<double>>;
 }
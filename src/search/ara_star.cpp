@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "ara_star.hpp"
+#include "search_space.hpp"
+
+namespace {
+    using namespace planner;
+
+    // clock is read once per this number of expansions
+    constexpr std::size_t deadline_check_period = 64;
+
+    template <typename OpenList>
+    SearchState& ara_search(
+        Point from,
+        Point to,
+        const GridMap<>& map,
+        SearchContext& context,
+        bool store_history,
+        const Heuristic<Point>& heuristic,
+        const TieBreaker& tie_breaker,
+        const Options& options,
+        const MoveRules& rules,
+        double weight_step,
+        std::chrono::microseconds deadline
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto deadline_time = std::chrono::steady_clock::now() + deadline;
+
+        SearchState& state = context.state;
+        state.reset();
+        GridMemory& memory = context.memory;
+        const std::size_t width = map.get_width();
+        const std::size_t cell_count = map.get_width() * map.get_height();
+        memory.reset(cell_count);
+        auto key = [width](const Point& point) { return point.y * width + point.x; };
+        auto estimate = [&heuristic, &to](const Point& point) { return heuristic(point, to); };
+
+        // every cell has a single node for the whole search, its distance and parent are improved in place
+        NodeIndex start = state.nodes.emplace(from, 0, estimate(from));
+        memory.open(key(from), start, 0);
+        const std::size_t goal_cell = key(to);
+
+        double weight = std::max(1.0, options.heuristic_weight);
+        std::vector<NodeIndex> inconsistent;  // improved after they were closed in the current iteration
+        std::vector<std::size_t> closed_cells;
+        std::vector<NodeIndex> seeds{ start };
+        std::size_t iterations = 0;
+        double bound = std::numeric_limits<double>::infinity();
+        bool out_of_time = false;
+
+        while (true) {
+            NodeComparator comparator{ weight, tie_breaker, state.nodes };
+            OpenList open{ comparator, cell_count, context.open };
+            for (NodeIndex index : seeds) {
+                std::size_t cell = key(state.nodes[index].position);
+                if (!open.contains(cell)) {
+                    open.push(cell, index);
+                }
+            }
+            ++iterations;
+
+            auto goal_distance = [&]() {
+                return memory.visited(goal_cell) ? memory[goal_cell].distance : std::numeric_limits<double>::infinity();
+            };
+            auto cumulative = [&](NodeIndex index) {
+                return state.nodes[index].distance + weight * state.nodes[index].estimation;
+            };
+            std::size_t expansions = 0;
+            while (!open.empty() && cumulative(open.top()) < goal_distance() && !very_close_equals(cumulative(open.top()), goal_distance())) {
+                if (state.path_found && deadline.count() != 0 && ++expansions % deadline_check_period == 0 && std::chrono::steady_clock::now() >= deadline_time) {
+                    out_of_time = true;
+                    break;
+                }
+                NodeIndex optimal = open.top();
+                open.pop();
+                const Point position = state.nodes[optimal].position;
+                const double distance = state.nodes[optimal].distance;
+                memory.close(key(position));
+                closed_cells.push_back(key(position));
+                state.closed_indices.push_back(optimal);
+
+                for (std::uint32_t successors = rules(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    std::size_t cell = key(point);
+                    double successor_distance = distance + MoveRules::cost(direction);
+                    if (!memory.visited(cell)) {
+                        NodeIndex index = state.nodes.emplace(point, successor_distance, estimate(point), optimal);
+                        memory.open(cell, index, successor_distance);
+                        open.push(cell, index);
+                    } else if (successor_distance < memory[cell].distance) {
+                        NodeIndex index = memory[cell].node;
+                        memory.relax(cell, successor_distance);
+                        auto improve = [&]() {
+                            state.nodes[index].distance = successor_distance;
+                            state.nodes[index].parent = optimal;
+                        };
+                        if (memory.closed(cell)) {
+                            improve();
+                            inconsistent.push_back(index);
+                        } else if (open.contains(cell)) {
+                            open.decrease(cell, improve);
+                        } else {
+                            improve();  // closed by a previous iteration
+                            open.push(cell, index);
+                        }
+                    }
+                }
+
+                if (store_history) {
+                    std::vector<Node> open_nodes;
+                    for (NodeIndex index : open.values()) {
+                        open_nodes.push_back(state.nodes[index]);
+                    }
+                    state.open_history.push_back(std::move(open_nodes));
+                    state.closed_history.push_back(state.closed_indices.size());
+                }
+            }
+
+            seeds = open.values();
+            seeds.insert(std::end(seeds), std::begin(inconsistent), std::end(inconsistent));
+            inconsistent.clear();
+            if (!memory.visited(goal_cell)) {
+                break;  // no path at all
+            }
+            state.path_found = true;
+            if (out_of_time) {
+                break;
+            }
+
+            // every unexpanded path passes through a seed, so the goal distance is within the bound of the optimum
+            double lower_bound = goal_distance();
+            for (NodeIndex index : seeds) {
+                lower_bound = std::min(lower_bound, state.nodes[index].distance + state.nodes[index].estimation);
+            }
+            bound = lower_bound > 0 ? std::min(weight, goal_distance() / lower_bound) : 1.0;
+            if (bound <= 1 || weight <= 1 || (deadline.count() != 0 && std::chrono::steady_clock::now() >= deadline_time)) {
+                break;
+            }
+
+            weight = std::max(1.0, weight - weight_step);
+            for (std::size_t cell : closed_cells) {
+                memory.reopen(cell);
+            }
+            closed_cells.clear();
+        }
+
+        if (state.path_found) {
+            for (NodeIndex current = memory[goal_cell].node; current != Node::none; current = state.nodes[current].parent) {
+                state.path_indices.push_back(current);
+            }
+            std::reverse(std::begin(state.path_indices), std::end(state.path_indices));
+            state.open_indices = seeds;
+            state.statistics["suboptimalitybound"] = std::max(1.0, bound);
+        }
+        state.statistics["iterations"] = static_cast<double>(iterations);
+        state.statistics["weight"] = weight;
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+
+        return state;
+    }
+}
+
+
+namespace planner {
+    AraStar::AraStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, double weight_step, std::chrono::microseconds deadline) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        weight_step(weight_step),
+        deadline(deadline)
+    {
+        if (weight_step <= 0) {
+            throw std::logic_error{ "weight step must be positive" };
+        }
+    }
+
+    const SearchState& AraStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        return dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            return ara_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, moves, weight_step, deadline);
+        });
+    }
+}
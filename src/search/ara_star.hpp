@@ -0,0 +1,24 @@
+#pragma once
+#include <chrono>
+#include <memory>
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Anytime Repairing A*: weighted A* starting with `Options::heuristic_weight`,
+    /// after every found path the weight is decreased by `weight_step` and the path is improved reusing the search tree,
+    /// until the weight reaches 1 or `deadline` passes, zero `deadline` means no time limit
+    /// the first path is always searched for to the end, the deadline is checked after it is found
+    class AraStar : public Search {
+        MoveRules moves;
+        double weight_step;
+        std::chrono::microseconds deadline;
+    public:
+        AraStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, double weight_step = 0.5, std::chrono::microseconds deadline = {});
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
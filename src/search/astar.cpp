@@ -1,219 +1,111 @@
+#include <cmath>
+#include <stdexcept>
+#include <utility>
 #include "astar.hpp"
-#include "float_comparison.hpp"
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
-#include <vector>
-#include <set>
+#include "moves.hpp"
+#include "search_space.hpp"
 
 namespace {
     using namespace planner;
 
-    using NodePtr = std::shared_ptr<Node>;
-
-    struct NodePtrComparator {
-        double heuristic_weight;
-        const TieBreaker& tie_breaker;
-
-        NodePtrComparator(double heuristic_weight, const TieBreaker& tie_breaker) :
-            heuristic_weight(heuristic_weight),
-            tie_breaker(tie_breaker)
-            {}
-
-        // <less> comparator: a < b
-        [[nodiscard]] bool operator () (const NodePtr& a, const NodePtr& b) const {
-            auto a_cumulative = a->distance + heuristic_weight * a->estimation;
-            auto b_cumulative = b->distance + heuristic_weight * b->estimation;
-            if (very_close_equals(a_cumulative, b_cumulative)) {
-                return tie_breaker(*a, *b);
-            }
-            return a_cumulative < b_cumulative;
-        }
-    };
-
-    struct SearchSpace {
-        std::set<NodePtr, NodePtrComparator> storage;
-        std::unordered_map<Point, decltype(storage)::const_iterator> checker;
-        std::unordered_set<Point> closed;
-
-        explicit SearchSpace(const NodePtrComparator& comparator) : storage{ comparator }, checker{} {}
-
-        void insert(const NodePtr& node_ptr) {
-            if (node_ptr) {
-                checker.emplace(node_ptr->position, storage.insert(node_ptr).first);
-            }
-        }
-
-        bool empty() const {
-            return storage.empty();
-        }
-
-        NodePtr optimal() const {
-            if (!empty()) {
-                return *storage.begin();
-            }
-            return nullptr;
-        }
-
-        void erase_optimal() {
-            checker.erase(optimal()->position);
-            storage.erase(storage.begin());
-        }
-
-        void close(const Point& position) {
-            closed.insert(position);
-        }
-
-        bool contains(const Point& point) const {
-            return checker.find(point) != checker.end();
-        }
-
-        decltype(storage)::const_iterator find(const Point& point) const {
-            auto iterator = checker.find(point);
-            if (iterator == checker.end()) {
-                return storage.end();
-            }
-            return iterator->second;
-        }
-
-        bool is_closed(const Point& point) {
-            return closed.find(point) != closed.end();
-        }
-
-        void erase(const Point& position) {
-            auto iterator = checker.find(position);
-            if (iterator != checker.end()) {
-                storage.erase(iterator->second);
-                checker.erase(iterator);
-            }
+    /// `Metric` is the type of the heuristic, it is called directly, if the type is final
+    template <typename OpenList, typename Metric = Heuristic<Point>>
+    void expand(
+        NodeIndex optimal,
+        const GridMap<>& map,
+        const Metric& heuristic,
+        const Point& destination,
+        SearchSpace<OpenList>& search_space,
+        const MoveRules& rules,
+        const GoalBounds* bounds
+    ) {
+        const Node& node = search_space.nodes[optimal];
+        const Point position = node.position;
+        const double distance = node.distance;
+        auto estimate = [&heuristic, &destination](const Point& point) { return heuristic(point, destination); };
+        std::uint32_t successors = rules(map.neighbourhood(position.x, position.y));
+        if (bounds != nullptr) {
+            successors &= bounds->moves_towards(position.y * map.get_width() + position.x, destination);
         }
-    };
-
-    // todo: move map movement options from `search` to `map` properties
-    std::vector<std::pair<Point, double>> generate_next_positions(const Point& position, const GridMap<>& map, bool allow_diagonal, bool cut_corners, bool allow_squeeze) {
-        std::vector<std::pair<int, int>> deltas = {
-            { -1, -1 },
-            { -1, 0 },
-            { -1, 1 },
-            { 0, 1 },
-            { 1, 1 },
-            { 1, 0 },
-            { 1, -1 },
-            { 0, -1 }
-        };
-
-        auto is_diagonal_delta = [](const std::pair<int, int>& delta) -> bool { return delta.first && delta.second; };
-        auto is_cut_corner_move = [&map](const Point& origin, const std::pair<int, int>& delta) -> int {
-            return map.bordered_at(origin.x + delta.first, origin.y) == CellType::obstacle ^
-                   map.bordered_at(origin.x, origin.y + delta.second) == CellType::obstacle;
-        };
-        auto is_squeeze_move = [&map](const Point& origin, const std::pair<int, int>& delta) -> int {
-            return map.bordered_at(origin.x + delta.first, origin.y) == CellType::obstacle &&
-                   map.bordered_at(origin.x, origin.y + delta.second) == CellType::obstacle;
-        };
-
-        std::vector<std::pair<Point, double>> next_positions;
-        for (const std::pair<int, int>& delta : deltas) {
-            Point next{ position.x + delta.first, position.y + delta.second };
-            if (map.bordered_at(next.x, next.y) == CellType::obstacle) {
-                continue;
-            }
-            if (is_diagonal_delta(delta)) {
-                if (!allow_diagonal) {
-                    continue;
-                }
-                if (is_cut_corner_move(position, delta)) {
-                    if (!cut_corners) {
-                        continue;
-                    }
-                } else if (is_squeeze_move(position, delta)) {
-                    if (!cut_corners || !allow_squeeze) {
-                        continue;
-                    }
-                }
-                next_positions.emplace_back(next, std::sqrt(2));  // todo: move `sqrt(2)` and `1` logic to metric distance determination
-            } else {
-                next_positions.emplace_back(next, 1);
-            }
+        for (; successors != 0; successors &= successors - 1) {
+            std::size_t direction = lowest_bit(successors);
+            Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+            search_space.reach(point, distance + MoveRules::cost(direction), optimal, estimate);
         }
-        return next_positions;
     }
 
-    void expand(
-        const NodePtr& optimal,
+    template <typename OpenList>
+    void expand_exact(
+        NodeIndex optimal,
         const GridMap<>& map,
         const Heuristic<Point>& heuristic,
         const Point& destination,
-        SearchSpace& search_space,
-        bool allow_diagonal,
-        bool cut_corners,
-        bool allow_squeeze
+        SearchSpace<OpenList>& search_space,
+        const MoveRules& rules,
+        const GoalBounds* bounds
     ) {
-        std::vector<std::pair<Point, double>> next_positions = generate_next_positions(optimal->position, map, allow_diagonal, cut_corners, allow_squeeze);
-        for (auto&& [point, distance] : next_positions) {
-            if (search_space.is_closed(point)) {
-                continue;
-            }
-            double candidate_distance = optimal->distance + distance;
-            if (search_space.contains(point)) {
-                NodePtr existing = *search_space.find(point);
-                if (candidate_distance < existing->distance) {
-                    search_space.erase(existing->position);
-                    auto new_node = std::make_shared<Node>(point, candidate_distance, heuristic(point, destination), optimal);
-                    search_space.insert(new_node);
-                }
-            } else {
-                auto new_node = std::make_shared<Node>(point, candidate_distance, heuristic(point, destination), optimal);
-                search_space.insert(new_node);
-            }
+        const Point position = search_space.nodes[optimal].position;
+        const number distance = (*search_space.exact)[optimal].distance;
+        auto estimate = [&heuristic, &destination](const Point& point) { return *heuristic.exact(point, destination); };
+        std::uint32_t successors = rules(map.neighbourhood(position.x, position.y));
+        if (bounds != nullptr) {
+            successors &= bounds->moves_towards(position.y * map.get_width() + position.x, destination);
+        }
+        for (; successors != 0; successors &= successors - 1) {
+            std::size_t direction = lowest_bit(successors);
+            Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+            search_space.reach_exact(point, distance + MoveRules::exact_cost(direction), optimal, estimate);
         }
     }
 }
 
 
 namespace planner {
-    SearchState AStar::search(Point from, Point to, const GridMap<CellType>& map, bool store_history) const {
-        auto start_time = std::chrono::high_resolution_clock::now();
-
-        NodePtrComparator comparator{ options.heuristic_weight, *tie_breaker };
-        SearchState state;
-        SearchSpace search_space{ comparator };
-        auto start = std::make_shared<Node>(from, 0, (*heuristic)(from, to), nullptr);
-        search_space.insert(start);
-
-        while (!search_space.empty()) {
-            NodePtr optimal = search_space.optimal();
-            if (optimal->position == to) {
-                state.path_found = true;
-                break;
+    AStar::AStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        bounds(options.goal_bounding ? std::make_unique<GoalBoundsCache>(options, std::move(cache_directory)) : nullptr)
+    {
+        if (options.exact_distances) {
+            if (options.heuristic_weight < 0 || options.heuristic_weight != std::floor(options.heuristic_weight)) {
+                throw std::logic_error{ "exact distances need a whole heuristic weight" };
             }
-            search_space.erase_optimal();
-            search_space.close(optimal->position);
-            expand(optimal, map, *heuristic, to, search_space, options.allow_diagonal, options.cut_corners, options.allow_squeeze);
-            state.closed.push_back(optimal);
-            if (store_history) {
-                state.open_history.emplace_back(std::begin(search_space.storage), std::end(search_space.storage));
-                state.closed_history.push_back(state.closed);
+            if (!this->heuristic->exact({ 0, 0 }, { 0, 0 }).has_value()) {
+                throw std::logic_error{ "exact distances need a heuristic with exact values" };
             }
         }
+    }
 
-        if (state.path_found) {
-            auto optimal = search_space.optimal();
-            while (optimal != nullptr) {
-                state.path.push_front(optimal);
-                optimal = optimal->expanded_from;
+    const SearchState& AStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        // bounds are built or loaded before the search, so it is not included in the search time
+        auto goal_bounds = bounds != nullptr ? bounds->get(map) : nullptr;
+        // the default open list with standard heuristics and tie breakers runs a kernel without virtual calls,
+        // move options need no specialization, as successors are already looked up in a table of `rules`
+        if (options.open_list == OpenListType::quaternary_heap && !options.exact_distances) {
+            SearchState* result = nullptr;
+            bool specialized = dispatch_kernel(*heuristic, *tie_breaker, [&](auto tag) {
+                using Metric = typename decltype(tag)::heuristic_type;
+                using OpenList = QuaternaryHeap<NodeIndex, BasicNodeComparator<typename decltype(tag)::tie_breaker_type>>;
+                const auto& metric = static_cast<const Metric&>(*heuristic);
+                result = &best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                    expand(optimal, map, metric, to, search_space, rules, goal_bounds.get());
+                });
+            });
+            if (specialized) {
+                return *result;
             }
-
-            optimal = search_space.optimal();
-            search_space.erase_optimal();
-            search_space.close(optimal->position);
-            state.closed.push_back(optimal);
-            state.open = { std::begin(search_space.storage), std::end(search_space.storage) };
         }
-
-        auto end_time = std::chrono::high_resolution_clock::now();
-        state.time_spent = end_time - start_time;
-
-        return state;
+        return dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            if (options.exact_distances) {
+                return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                    expand_exact(optimal, map, *heuristic, to, search_space, rules, goal_bounds.get());
+                }, true);
+            }
+            return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                expand(optimal, map, *heuristic, to, search_space, rules, goal_bounds.get());
+            });
+        });
     }
 }
@@ -1,12 +1,21 @@
 #pragma once
+#include <memory>
+#include <string>
+#include "goal_bounding.hpp"
 #include "interface.hpp"
 
 
 namespace planner {
+    /// with `exact_distances` the heuristic must have exact values (diagonal, manhattan, euclidean or chebyshev metric)
+    /// and its weight must be a whole number
+    /// with `goal_bounding` goal bounds are kept like `PathDatabaseSearch` databases, in `cache_directory` if it is not empty
     class AStar : public Search {
+        std::unique_ptr<GoalBoundsCache> bounds;  // only with `goal_bounding`
     public:
-        using Search::Search;
+        AStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory = {});
 
-        [[nodiscard]] SearchState search(Point from, Point to, const GridMap<CellType>& map,  bool store_history = false) const override;
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
     };
 }
@@ -0,0 +1,136 @@
+#include <array>
+#include <limits>
+#include "bidirectional.hpp"
+#include "moves.hpp"
+#include "search_space.hpp"
+
+namespace {
+    using namespace planner;
+
+    template <typename OpenList>
+    SearchState& bidirectional_search(
+        Point from,
+        Point to,
+        const GridMap<>& map,
+        SearchContext& context,
+        bool store_history,
+        const Heuristic<Point>& heuristic,
+        const TieBreaker& tie_breaker,
+        const Options& options,
+        const MoveRules& rules
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SearchState& state = context.state;
+        state.reset();
+        NodeComparator comparator{ options.heuristic_weight, tie_breaker, state.nodes };
+        SearchSpace<OpenList> forward{ state.nodes, context.memory, comparator, map, context.open };
+        SearchSpace<OpenList> backward{ state.nodes, context.reverse_memory, comparator, map, context.reverse_open };
+        std::array<SearchSpace<OpenList>*, 2> spaces{ &forward, &backward };
+        std::array<std::size_t, 2> steps{ 0, 0 };
+
+        // balanced potentials, the backward one is the negated forward one, so both frontiers order nodes consistently
+        auto potential = [&heuristic, &from, &to](const Point& point) {
+            return (heuristic(point, to) - heuristic(from, point)) / 2;
+        };
+        forward.insert(state.nodes.emplace(from, 0, potential(from)));
+        backward.insert(state.nodes.emplace(to, 0, -potential(to)));
+
+        // shortest path through a cell reached by both frontiers
+        double best_length = std::numeric_limits<double>::infinity();
+        std::size_t meeting = std::numeric_limits<std::size_t>::max();
+        auto meet = [&](std::size_t cell) {
+            if (forward.memory.visited(cell) && backward.memory.visited(cell)) {
+                double length = forward.memory[cell].distance + backward.memory[cell].distance;
+                if (length < best_length) {
+                    best_length = length;
+                    meeting = cell;
+                }
+            }
+        };
+        meet(forward.key(from));
+
+        auto cumulative = [&](NodeIndex index) {
+            return state.nodes[index].distance + options.heuristic_weight * state.nodes[index].estimation;
+        };
+
+        while (!forward.empty() && !backward.empty()) {
+            double bound = cumulative(forward.optimal()) + cumulative(backward.optimal());
+            if (bound >= best_length || very_close_equals(bound, best_length)) {
+                break;
+            }
+
+            std::size_t side = forward.size() <= backward.size() ? 0 : 1;
+            SearchSpace<OpenList>& space = *spaces[side];
+            const SearchSpace<OpenList>& other = *spaces[1 - side];
+            NodeIndex optimal = space.optimal();
+            space.erase_optimal();
+            const Point position = state.nodes[optimal].position;
+            const double distance = state.nodes[optimal].distance;
+            space.close(position);
+            state.closed_indices.push_back(optimal);
+            ++steps[side];
+
+            // the other frontier already knows the shortest path from this cell to its start, it is accounted for in `best_length`
+            if (!other.memory.closed(space.key(position))) {
+                const double sign = side == 0 ? 1.0 : -1.0;
+                auto estimate = [&potential, sign](const Point& point) { return sign * potential(point); };
+                for (std::uint32_t successors = rules(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    space.reach(point, distance + MoveRules::cost(direction), optimal, estimate);
+                    meet(space.key(point));
+                }
+            }
+
+            if (store_history) {
+                std::vector<Node> open_nodes;
+                for (const auto* search_space : spaces) {
+                    for (NodeIndex index : search_space->open_nodes()) {
+                        open_nodes.push_back(state.nodes[index]);
+                    }
+                }
+                state.open_history.push_back(std::move(open_nodes));
+                state.closed_history.push_back(state.closed_indices.size());
+            }
+        }
+
+        if (meeting != std::numeric_limits<std::size_t>::max()) {
+            state.path_found = true;
+            for (NodeIndex current = forward.memory[meeting].node; current != Node::none; current = state.nodes[current].parent) {
+                state.path_indices.push_back(current);
+            }
+            std::reverse(std::begin(state.path_indices), std::end(state.path_indices));
+            // backward nodes point towards the finish, they are copied with distances from the start
+            for (NodeIndex current = state.nodes[backward.memory[meeting].node].parent; current != Node::none; current = state.nodes[current].parent) {
+                const Point position = state.nodes[current].position;
+                const Node& previous = state.nodes[state.path_indices.back()];
+                double distance = previous.distance + MoveRules::cost(direction_between(previous.position, position));
+                state.path_indices.push_back(state.nodes.emplace(position, distance, potential(position), state.path_indices.back()));
+            }
+            for (const auto* search_space : spaces) {
+                auto open_nodes = search_space->open_nodes();
+                state.open_indices.insert(std::end(state.open_indices), std::begin(open_nodes), std::end(open_nodes));
+            }
+        }
+        state.statistics["forwardsteps"] = static_cast<double>(steps[0]);
+        state.statistics["backwardsteps"] = static_cast<double>(steps[1]);
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+
+        return state;
+    }
+}
+
+
+namespace planner {
+    const SearchState& BidirectionalAStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        return dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            return bidirectional_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, rules);
+        });
+    }
+}
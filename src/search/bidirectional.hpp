@@ -0,0 +1,18 @@
+#pragma once
+#include "interface.hpp"
+
+
+namespace planner {
+    /// Bidirectional A*, searches forward from the start and backward from the finish, expanding the smaller frontier
+    /// frontiers are ordered by the average of the heuristic towards their target and the negated heuristic towards their start,
+    /// the search stops when the sum of the frontier minimums reaches the best found meeting,
+    /// so with a consistent heuristic the path is as short as the one found by `AStar`
+    class BidirectionalAStar : public Search {
+    public:
+        using Search::Search;
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <chrono>
+#include "breadth_first.hpp"
+#include "context.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    /// word `i` of the row with every cell moved one column right (`x + 1`)
+    std::uint64_t shifted_right(const std::uint64_t* row, std::size_t i) {
+        return (row[i] << 1u) | (i > 0 ? row[i - 1] >> 63u : 0);
+    }
+
+    /// word `i` of the row with every cell moved one column left (`x - 1`)
+    std::uint64_t shifted_left(const std::uint64_t* row, std::size_t i, std::size_t count) {
+        return (row[i] >> 1u) | (i + 1 < count ? row[i + 1] << 63u : 0);
+    }
+
+    RowBitset build_free_cells(const GridMap<>& map) {
+        RowBitset bits;
+        bits.words_per_row = (map.get_width() + 63) / 64;
+        bits.words.assign(bits.words_per_row * map.get_height(), 0);
+        for (std::size_t y = 0; y < map.get_height(); ++y) {
+            for (std::size_t x = 0; x < map.get_width(); ++x) {
+                if (map(x, y) != CellType::obstacle) {
+                    bits.words[y * bits.words_per_row + x / 64] |= std::uint64_t{ 1 } << (x % 64);
+                }
+            }
+        }
+        return bits;
+    }
+}
+
+
+namespace planner {
+    BreadthFirst::BreadthFirst(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        free_cells{}
+    {}
+
+    const SearchState& BreadthFirst::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool /* store_history */) const {
+        check_heuristic(map);
+        auto free_bits = free_cells.get(map, [&map]() { return std::make_shared<const RowBitset>(build_free_cells(map)); });
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SearchState& state = context.state;
+        state.reset();
+        const std::size_t height = map.get_height();
+        const std::size_t row_size = free_bits->words_per_row;
+        const std::size_t word_count = free_bits->words.size();
+        const std::uint64_t* free = free_bits->words.data();
+        BreadthFirstBuffers& buffers = context.breadth_first;
+        auto& visited = buffers.visited;
+        auto& frontier = buffers.frontier;
+        auto& next = buffers.next;
+        auto& low_parity = buffers.low_parity;
+        auto& high_parity = buffers.high_parity;
+        auto& empty_row = buffers.empty_row;
+        auto& rows = buffers.rows;
+        auto& next_rows = buffers.next_rows;
+        auto& begin = buffers.begin;
+        auto& end = buffers.end;
+        auto& next_begin = buffers.next_begin;
+        auto& next_end = buffers.next_end;
+        empty_row.assign(row_size, 0);
+        visited.assign(word_count, 0);
+        frontier.assign(word_count, 0);
+        next.assign(word_count, 0);
+        // ascending indices of frontier rows, every frontier row is zero outside of its word range `[begin, end)`, other rows are zero
+        rows.assign(1, from.y);
+        next_rows.clear();
+        begin.assign(height, 0);
+        end.assign(height, 0);
+        next_begin.assign(height, 0);
+        next_end.assign(height, 0);
+        // layer numbers modulo 3 of visited cells in two bit planes, enough to tell the previous layer from the same and the next one
+        low_parity.assign(word_count, 0);
+        high_parity.assign(word_count, 0);
+        auto is_set = [row_size](const std::vector<std::uint64_t>& bits, std::size_t x, std::size_t y) {
+            return (bits[y * row_size + x / 64] >> (x % 64)) & 1u;
+        };
+        // a diagonal move passes the cell of the source row in the target column and the cell of the target row in the source column,
+        // `corner(a, b)` tells, which moves are allowed by the free masks of these cells
+        const bool cut_corners = options.allow_diagonal && options.cut_corners;
+        const bool allow_squeeze = cut_corners && options.allow_squeeze;
+        auto corner = [cut_corners, allow_squeeze](std::uint64_t a, std::uint64_t b) -> std::uint64_t {
+            return allow_squeeze ? ~std::uint64_t{ 0 } : cut_corners ? a | b : a & b;
+        };
+
+        frontier[from.y * row_size + from.x / 64] |= std::uint64_t{ 1 } << (from.x % 64);
+        visited[from.y * row_size + from.x / 64] = frontier[from.y * row_size + from.x / 64];
+        begin[from.y] = static_cast<std::uint32_t>(from.x / 64);
+        end[from.y] = begin[from.y] + 1;
+        std::size_t visited_cells = 1;
+        std::uint32_t layer = 0;
+
+        auto expand_row = [&](std::size_t y) {
+            // cells can only be reached from the words of the three frontier rows around, or over the edges of these words
+            std::size_t low = row_size, high = 0;
+            for (std::size_t row : { y - 1, y, y + 1 }) {
+                if (row < height && begin[row] < end[row]) {
+                    const std::uint64_t* words = frontier.data() + row * row_size;
+                    low = std::min<std::size_t>(low, begin[row] - (begin[row] > 0 && (words[begin[row]] & 1u) ? 1 : 0));
+                    high = std::max<std::size_t>(high, end[row] + (end[row] < row_size && (words[end[row] - 1] >> 63u) ? 1 : 0));
+                }
+            }
+            const std::uint64_t* current = frontier.data() + y * row_size;
+            const std::uint64_t* up = y > 0 ? current - row_size : empty_row.data();
+            const std::uint64_t* down = y + 1 < height ? current + row_size : empty_row.data();
+            const std::uint64_t* free_row = free + y * row_size;
+            const std::uint64_t* free_up = y > 0 ? free_row - row_size : empty_row.data();
+            const std::uint64_t* free_down = y + 1 < height ? free_row + row_size : empty_row.data();
+            std::uint64_t* target = next.data() + y * row_size;
+            std::uint64_t* visited_row = visited.data() + y * row_size;
+            std::size_t reached_begin = high, reached_end = low;
+            for (std::size_t i = low; i < high; ++i) {
+                std::uint64_t reached = shifted_right(current, i) | shifted_left(current, i, row_size) | up[i] | down[i];
+                if (options.allow_diagonal) {
+                    const std::uint64_t free_right = shifted_right(free_row, i), free_left = shifted_left(free_row, i, row_size);
+                    reached |= shifted_right(up, i) & corner(free_up[i], free_right);
+                    reached |= shifted_left(up, i, row_size) & corner(free_up[i], free_left);
+                    reached |= shifted_right(down, i) & corner(free_down[i], free_right);
+                    reached |= shifted_left(down, i, row_size) & corner(free_down[i], free_left);
+                }
+                reached &= free_row[i] & ~visited_row[i];
+                if (reached == 0) {
+                    continue;
+                }
+                target[i] = reached;
+                visited_row[i] |= reached;
+                reached_begin = std::min(reached_begin, i);
+                reached_end = i + 1;
+                low_parity[y * row_size + i] |= layer % 3 == 1 ? reached : 0;
+                high_parity[y * row_size + i] |= layer % 3 == 2 ? reached : 0;
+                visited_cells += bit_count_64(reached);
+            }
+            if (reached_begin < reached_end) {
+                next_begin[y] = static_cast<std::uint32_t>(reached_begin);
+                next_end[y] = static_cast<std::uint32_t>(reached_end);
+                next_rows.push_back(y);
+            }
+        };
+
+        bool found = from == to;
+        while (!found && !rows.empty()) {
+            ++layer;
+            next_rows.clear();
+            std::size_t unprocessed = 0;  // rows below are already expanded in this layer
+            for (std::size_t row : rows) {
+                for (std::size_t y = std::max(row == 0 ? 0 : row - 1, unprocessed); y <= row + 1 && y < height; ++y) {
+                    expand_row(y);
+                    unprocessed = y + 1;
+                }
+            }
+            for (std::size_t row : rows) {
+                std::fill(frontier.data() + row * row_size + begin[row], frontier.data() + row * row_size + end[row], 0);
+                begin[row] = end[row] = 0;
+            }
+            std::swap(frontier, next);
+            std::swap(begin, next_begin);
+            std::swap(end, next_end);
+            std::swap(rows, next_rows);
+            found = is_set(visited, to.x, to.y);
+        }
+
+        if (found) {
+            // moves are symmetric, so a previous cell is a neighbour reachable by an allowed move from the layer before
+            std::vector<Point> cells;
+            cells.reserve(layer + 1);
+            cells.push_back(to);
+            // neighbours of a cell are in the layers before, after or in the same layer as the cell
+            auto in_layer = [&](std::size_t number, const Point& point) {
+                return is_set(visited, point.x, point.y) &&
+                    is_set(low_parity, point.x, point.y) == (number % 3 == 1) &&
+                    is_set(high_parity, point.x, point.y) == (number % 3 == 2);
+            };
+            for (std::uint32_t current = layer; current > 0; --current) {
+                const Point position = cells.back();
+                for (std::uint32_t successors = moves(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point previous{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    if (in_layer(current - 1, previous)) {
+                        cells.push_back(previous);
+                        break;
+                    }
+                }
+            }
+            state.path_found = true;
+            double distance = 0;
+            for (auto it = cells.rbegin(); it != cells.rend(); ++it) {
+                if (it != cells.rbegin()) {
+                    distance += MoveRules::cost(direction_between(*std::prev(it), *it));
+                }
+                Node::index_type parent = state.path_indices.empty() ? Node::none : state.path_indices.back();
+                state.path_indices.push_back(state.nodes.emplace(*it, distance, (*heuristic)(*it, to), parent));
+            }
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+        state.statistics["visitedcells"] = static_cast<double>(visited_cells);
+        state.statistics["layers"] = static_cast<double>(layer);
+        return state;
+    }
+}
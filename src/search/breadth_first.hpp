@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Grid cells packed into rows of 64 bit words, cell (x, y) is bit `x % 64` of word `y * words_per_row + x / 64`
+    struct RowBitset {
+        std::size_t words_per_row = 0;
+        std::vector<std::uint64_t> words;
+    };
+
+    /// Arrays of a breadth first search, kept in a `SearchContext` and refilled by every search
+    struct BreadthFirstBuffers {
+        std::vector<std::uint64_t> visited, frontier, next, low_parity, high_parity, empty_row;  // row bitsets
+        std::vector<std::size_t> rows, next_rows;
+        std::vector<std::uint32_t> begin, end, next_begin, next_end;  // word ranges of frontier rows
+    };
+
+    /// Breadth first search counting every move as one step, so paths have the least number of moves,
+    /// whole rows of the frontier are expanded at once with word shifts, masked by free cells of the map
+    class BreadthFirst : public Search {
+        MoveRules moves;
+        MapCache<RowBitset> free_cells;
+    public:
+        BreadthFirst(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options);
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
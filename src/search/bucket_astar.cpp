@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+#include "bucket_astar.hpp"
+#include "context.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    // buckets per unit of distance, values inside a bucket are ordered by a heap
+    constexpr double resolution = 4.0;
+
+    std::size_t bucket(const number& cost) {
+        return static_cast<std::size_t>(evaluate(cost) * resolution);
+    }
+}
+
+
+namespace planner {
+    BucketAStar::BucketAStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        metric(Metric::zero),
+        prefer_larger_distance(dynamic_cast<const GMin*>(this->tie_breaker.get()) == nullptr)
+    {
+        if (options.heuristic_weight != 0 && options.heuristic_weight != 1) {
+            throw std::logic_error{ "bucket search supports heuristic weights 0 and 1 only" };
+        }
+        const Heuristic<Point>* base = this->heuristic.get();
+        if (options.heuristic_weight == 0) {
+            metric = Metric::zero;
+        } else if (dynamic_cast<const Diagonal<Point>*>(base) != nullptr) {
+            metric = Metric::diagonal;
+        } else if (dynamic_cast<const Manhattan<Point>*>(base) != nullptr) {
+            metric = Metric::manhattan;
+        } else if (dynamic_cast<const Chebyshev<Point>*>(base) != nullptr) {
+            metric = Metric::chebyshev;
+        } else if (dynamic_cast<const Euclidean<Point>*>(base) != nullptr) {
+            metric = options.allow_diagonal ? Metric::diagonal : Metric::manhattan;
+        } else {
+            throw std::logic_error{ "bucket search supports diagonal, manhattan, chebyshev and euclidean metrics only" };
+        }
+    }
+
+    const SearchState& BucketAStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SearchState& state = context.state;
+        state.reset();
+        GridMemory& memory = context.memory;
+        const std::size_t width = map.get_width();
+        memory.reset(width * map.get_height());
+        auto key = [width](const Point& point) { return point.y * width + point.x; };
+        auto estimate = [this, &to](const Point& point) {
+            const int dx = static_cast<int>(std::max(point.x, to.x) - std::min(point.x, to.x));
+            const int dy = static_cast<int>(std::max(point.y, to.y) - std::min(point.y, to.y));
+            switch (metric) {
+                case Metric::diagonal:
+                    return number{ std::max(dx, dy) - std::min(dx, dy), std::min(dx, dy) };
+                case Metric::manhattan:
+                    return number{ dx + dy };
+                case Metric::chebyshev:
+                    return number{ std::max(dx, dy) };
+                default:
+                    return number{};
+            }
+        };
+
+        std::vector<number>& distances = context.bucket_astar.distances;
+        distances.clear();
+        auto& queue = context.bucket_astar.queue;
+        queue.clear(BucketEntryComparator{ prefer_larger_distance });
+        auto is_current = [&](const BucketEntry& entry) {
+            return !memory.closed(key(state.nodes[entry.node].position)) && distances[entry.node] == entry.distance;
+        };
+        auto snapshot = [&]() {
+            std::vector<Node> result;
+            queue.for_each([&](const BucketEntry& entry) {
+                if (is_current(entry)) {
+                    result.push_back(state.nodes[entry.node]);
+                }
+            });
+            return result;
+        };
+
+        const number start_estimate = estimate(from);
+        Node::index_type start = state.nodes.emplace(from, 0, evaluate(start_estimate));
+        distances.emplace_back();
+        memory.open(key(from), start, 0);
+        queue.push(bucket(start_estimate), BucketEntry{ start_estimate, number{}, start });
+
+        Node::index_type goal = Node::none;
+        while (!queue.empty()) {
+            const BucketEntry entry = queue.top();
+            queue.pop();
+            // the node has been closed or reached by a shorter path after the entry was pushed
+            if (!is_current(entry)) {
+                continue;
+            }
+            const Point position = state.nodes[entry.node].position;
+            memory.close(key(position));
+            if (position == to) {
+                goal = entry.node;
+                break;
+            }
+            for (std::uint32_t successors = moves(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                std::size_t direction = lowest_bit(successors);
+                Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                const std::size_t cell = key(point);
+                const number distance = entry.distance + MoveRules::exact_cost(direction);
+                const number point_estimate = estimate(point);
+                Node::index_type index;
+                if (memory.visited(cell)) {
+                    index = memory[cell].node;
+                    if (memory.closed(cell) || !(distance < distances[index])) {
+                        continue;
+                    }
+                    distances[index] = distance;
+                    state.nodes[index].distance = evaluate(distance);
+                    state.nodes[index].parent = entry.node;
+                    memory.relax(cell, state.nodes[index].distance);
+                } else {
+                    index = state.nodes.emplace(point, evaluate(distance), evaluate(point_estimate), entry.node);
+                    distances.push_back(distance);
+                    memory.open(cell, index, state.nodes[index].distance);
+                }
+                queue.push(bucket(distance + point_estimate), BucketEntry{ distance + point_estimate, distance, index });
+            }
+            state.closed_indices.push_back(entry.node);
+            if (store_history) {
+                state.open_history.push_back(snapshot());
+                state.closed_history.push_back(state.closed_indices.size());
+            }
+        }
+
+        if (goal != Node::none) {
+            state.path_found = true;
+            for (Node::index_type current = goal; current != Node::none; current = state.nodes[current].parent) {
+                state.path_indices.push_back(current);
+            }
+            std::reverse(std::begin(state.path_indices), std::end(state.path_indices));
+            state.closed_indices.push_back(goal);
+            queue.for_each([&](const BucketEntry& entry) {
+                if (is_current(entry)) {
+                    state.open_indices.push_back(entry.node);
+                }
+            });
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+        return state;
+    }
+}
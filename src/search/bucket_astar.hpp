@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "bucket_queue.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+#include "../quadratic.hpp"
+
+
+namespace planner {
+    struct BucketEntry {
+        number cost;  // F = g + h
+        number distance;
+        Node::index_type node;
+    };
+
+    struct BucketEntryComparator {
+        bool prefer_larger_distance = true;
+
+        [[nodiscard]] bool operator () (const BucketEntry& a, const BucketEntry& b) const {
+            if (int order = exact_sign(a.cost - b.cost); order != 0) {
+                return order < 0;
+            }
+            return prefer_larger_distance ? b.distance < a.distance : a.distance < b.distance;
+        }
+    };
+
+    /// Open list of a bucket search, kept in a `SearchContext` and cleared by every search
+    struct BucketAStarBuffers {
+        std::vector<number> distances;  // exact distance of every node
+        BucketQueue<BucketEntry, BucketEntryComparator> queue;
+    };
+
+    /// A* with exact distances and heuristic values of the form `a + b * sqrt(2)` (`number`) over a bucket queue keyed by quantized `F`,
+    /// nodes are ordered by exact comparisons, so there are no floating point tolerances in the search
+    /// heuristic weight must be 0 or 1, the diagonal, manhattan and chebyshev metrics are exact,
+    /// the euclidean metric is replaced by the exact distance of the move rules (octile or manhattan), which is admissible as well
+    /// ties are broken by `GMin` or `GMax`, other tie breakers are treated as `GMax`
+    class BucketAStar : public Search {
+        enum class Metric : std::uint8_t {
+            zero,
+            diagonal,
+            manhattan,
+            chebyshev,
+        };
+
+        MoveRules moves;
+        Metric metric;
+        bool prefer_larger_distance;
+    public:
+        BucketAStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options);
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
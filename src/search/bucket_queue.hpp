@@ -0,0 +1,122 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace planner {
+    /// Priority queue for almost monotone keys: values are spread over buckets by an integer key,
+    /// only the bucket of the least key is ordered, by a heap with `Compare` as a <less> comparator,
+    /// other buckets are unordered and are heapified when they become the least one
+    /// pushing a key below the least one is allowed, but moves the current heap back to its bucket
+    /// values are never updated in place, outdated values are expected to be skipped by the caller (lazy deletion)
+    template <typename T, typename Compare>
+    class BucketQueue {
+        struct HeapCompare {
+            Compare compare;
+
+            [[nodiscard]] bool operator () (const T& a, const T& b) const {
+                return compare(b, a);
+            }
+        };
+
+        HeapCompare heap_compare;
+        std::vector<std::vector<T>> buckets;
+        std::vector<T> heap;
+        std::size_t current = 0;
+        std::size_t count = 0;
+
+        void load(std::size_t key) {
+            current = key;
+            // copied instead of swapped, so every bucket keeps its capacity for later searches
+            heap.assign(std::begin(buckets[key]), std::end(buckets[key]));
+            buckets[key].clear();
+            std::make_heap(std::begin(heap), std::end(heap), heap_compare);
+        }
+    public:
+        explicit BucketQueue(const Compare& compare = Compare{}) : heap_compare{ compare } {}
+
+        [[nodiscard]] bool empty() const {
+            return count == 0;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return count;
+        }
+
+        [[nodiscard]] const T& top() const {
+            return heap.front();
+        }
+
+        void pop() {
+            std::pop_heap(std::begin(heap), std::end(heap), heap_compare);
+            heap.pop_back();
+            if (--count != 0 && heap.empty()) {
+                std::size_t key = current + 1;
+                while (buckets[key].empty()) {
+                    ++key;
+                }
+                load(key);
+            }
+        }
+
+        void push(std::size_t key, const T& value) {
+            if (key >= buckets.size()) {
+                buckets.resize(std::max(key + 1, 2 * buckets.size()));
+            }
+            if (count == 0) {
+                current = key;
+            } else if (key < current) {
+                buckets[current].insert(std::end(buckets[current]), std::begin(heap), std::end(heap));
+                heap.clear();
+                load(key);
+            }
+            ++count;
+            if (key == current) {
+                heap.push_back(value);
+                std::push_heap(std::begin(heap), std::end(heap), heap_compare);
+            } else {
+                buckets[key].push_back(value);
+            }
+        }
+
+        /// keeps allocated buckets for the next use
+        void clear() {
+            // buckets below the current one are always empty
+            for (std::size_t key = current; key < buckets.size(); ++key) {
+                buckets[key].clear();
+            }
+            heap.clear();
+            count = 0;
+        }
+
+        /// like `clear`, and values pushed later are ordered by `compare`
+        void clear(const Compare& compare) {
+            clear();
+            heap_compare.compare = compare;
+        }
+
+        /// calls `visit(value)` for every stored value in unspecified order
+        template <typename Visit>
+        void for_each(Visit visit) const {
+            for (const T& value : heap) {
+                visit(value);
+            }
+            for (std::size_t key = current + 1, left = count - heap.size(); left > 0; ++key) {
+                for (const T& value : buckets[key]) {
+                    visit(value);
+                }
+                left -= buckets[key].size();
+            }
+        }
+
+        [[nodiscard]] std::vector<T> values() const {
+            std::vector<T> result{ heap };
+            for (std::size_t key = current + 1; result.size() < count; ++key) {
+                result.insert(std::end(result), std::begin(buckets[key]), std::end(buckets[key]));
+            }
+            return result;
+        }
+    };
+}
@@ -0,0 +1,56 @@
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include "cache.hpp"
+
+
+namespace {
+    /// finalizer of splitmix64, every bit of the result depends on every bit of the value
+    std::uint64_t mix(std::uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31u);
+    }
+}
+
+
+namespace planner {
+    SidecarFile::SidecarFile(const std::string& directory, const GridMap<>& map, bool allow_diagonal, bool cut_corners, bool allow_squeeze, const std::string& extension) :
+        key(mix(map.fingerprint() ^ mix(allow_diagonal | cut_corners << 1u | allow_squeeze << 2u))),
+        path{}
+    {
+        std::stringstream filename;
+        filename << directory << '/' << std::hex << std::setw(16) << std::setfill('0') << key << extension;
+        path = filename.str();
+    }
+
+    bool SidecarFile::save(const std::function<void(std::ostream&)>& write) const {
+        // another process may write the same file at the same time, so the temporary name is random
+        std::stringstream temporary;
+        temporary << path << '.' << std::hex << std::random_device{}() << std::random_device{}() << ".tmp";
+        {
+            std::ofstream output{ temporary.str(), std::ios::binary };
+            if (!output) {
+                return false;
+            }
+            write(output);
+            output.close();
+            if (!output) {
+                std::error_code error;
+                std::filesystem::remove(temporary.str(), error);
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary.str(), path, error);
+        if (error) {
+            std::filesystem::remove(temporary.str(), error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "../map.hpp"
+
+
+namespace planner {
+    /// Data precomputed for a map and shared by all searches on it, rebuilt when a map of another revision is given
+    /// safe to use from several threads
+    template <typename T>
+    class MapCache {
+        mutable std::mutex mutex;
+        mutable std::uint64_t revision = 0;
+        mutable std::shared_ptr<const T> value;
+    public:
+        template <typename Build>
+        std::shared_ptr<const T> get(const GridMap<>& map, Build build) const {
+            std::lock_guard<std::mutex> lock{ mutex };
+            if (value == nullptr || revision != map.get_revision()) {
+                value = build();
+                revision = map.get_revision();
+            }
+            return value;
+        }
+
+        /// like `get`, but `build(previous)` also receives the data built for the previously given revision or `nullptr`,
+        /// so that parts unaffected by map changes can be reused
+        template <typename Build>
+        std::shared_ptr<const T> get_incremental(const GridMap<>& map, Build build) const {
+            std::lock_guard<std::mutex> lock{ mutex };
+            if (value == nullptr || revision != map.get_revision()) {
+                value = build(value.get());
+                revision = map.get_revision();
+            }
+            return value;
+        }
+    };
+
+    /// File of data precomputed for a map in a cache directory, named by a hash of the map cells and move options
+    class SidecarFile {
+        std::uint64_t key;
+        std::string path;
+    public:
+        SidecarFile(const std::string& directory, const GridMap<>& map, bool allow_diagonal, bool cut_corners, bool allow_squeeze, const std::string& extension);
+
+        /// identifies the map and move options, stored in the file to be checked on load
+        [[nodiscard]] std::uint64_t get_key() const {
+            return key;
+        }
+
+        [[nodiscard]] const std::string& get_path() const {
+            return path;
+        }
+
+        /// writes the file by `write` to a temporary file next to it and renames it over the file,
+        /// so readers never see a partially written file, and those, which opened or mapped the previous one, keep it
+        /// returns whether the file is written
+        bool save(const std::function<void(std::ostream&)>& write) const;
+    };
+}
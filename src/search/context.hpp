@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "breadth_first.hpp"
+#include "bucket_astar.hpp"
+#include "interface.hpp"
+#include "memory.hpp"
+#include "open_list.hpp"
+
+
+namespace planner {
+    /// Memory reused by consecutive searches, one context must not be used by concurrent searches
+    class SearchContext {
+    public:
+        SearchState state;
+        GridMemory memory;
+        GridMemory reverse_memory;  // backward frontier of bidirectional searches
+        GridMemory explored;  // cells h-reachable from the endpoints of subgoal graph searches
+        OpenListBuffers<Node::index_type> open;
+        OpenListBuffers<Node::index_type> reverse_open;
+        std::vector<std::uint32_t> fringe;  // list links of fringe search, two per cell
+        BreadthFirstBuffers breadth_first;
+        BucketAStarBuffers bucket_astar;
+        std::vector<ExactCost> exact;  // exact values of nodes by their indices, when distances are exact
+    };
+}
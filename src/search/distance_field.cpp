@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include "distance_field.hpp"
+#include "bucket_queue.hpp"
+#include "../quadratic.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    constexpr std::array<char, 8> field_magic = { 'F', 'L', 'O', 'W', 'F', 'L', 'D', '1' };
+
+    // buckets per unit of distance, values inside a bucket are ordered by a heap
+    constexpr double resolution = 4.0;
+
+    struct Entry {
+        number distance;
+        std::size_t cell;
+    };
+
+    struct EntryComparator {
+        [[nodiscard]] bool operator () (const Entry& a, const Entry& b) const {
+            return a.distance < b.distance;
+        }
+    };
+
+    std::size_t bucket(const number& distance) {
+        return static_cast<std::size_t>(evaluate(distance) * resolution);
+    }
+
+    std::size_t opposite(std::size_t direction) {
+        return (direction + directions.size() / 2) % directions.size();
+    }
+
+    /// cells in `[min_x, max_x) x [min_y, max_y)`
+    struct Tile {
+        std::size_t min_x, min_y, max_x, max_y;
+
+        [[nodiscard]] bool contains(std::size_t x, std::size_t y) const {
+            return min_x <= x && x < max_x && min_y <= y && y < max_y;
+        }
+
+        [[nodiscard]] bool on_border(std::size_t x, std::size_t y) const {
+            return x == min_x || x + 1 == max_x || y == min_y || y + 1 == max_y;
+        }
+    };
+
+    /// Dijkstra search restricted to a tile, `distances` and `moves` are shared by all tiles,
+    /// but a search writes only cells of its own tile and reads cells around it
+    class TileSearch {
+        const GridMap<>& map;
+        const MoveRules& rules;
+        std::vector<number>& distances;
+        std::vector<std::uint8_t>& reached;  // bytes, not bits, so that threads write cells of their tiles independently
+        std::vector<std::uint8_t>& moves;
+        BucketQueue<Entry, EntryComparator> queue;
+
+        void update(std::size_t cell, const number& distance, std::size_t move) {
+            if (!reached[cell] || distance < distances[cell]) {
+                reached[cell] = 1;
+                distances[cell] = distance;
+                moves[cell] = static_cast<std::uint8_t>(move);
+                queue.push(bucket(distance), { distance, cell });
+            }
+        }
+    public:
+        TileSearch(const GridMap<>& map, const MoveRules& rules, std::vector<number>& distances, std::vector<std::uint8_t>& reached, std::vector<std::uint8_t>& moves) :
+            map(map),
+            rules(rules),
+            distances(distances),
+            reached(reached),
+            moves(moves),
+            queue{}
+        {}
+
+        /// improves distances of the tile from the goal and from cells around the tile, returns whether a border cell has changed
+        bool run(const Tile& tile, Point goal) {
+            const std::size_t width = map.get_width();
+            queue.clear();
+            if (tile.contains(goal.x, goal.y) && !reached[goal.y * width + goal.x]) {
+                update(goal.y * width + goal.x, number{ 0, 0 }, DistanceField::no_move);
+            }
+            for (std::size_t y = tile.min_y; y < tile.max_y; ++y) {
+                // only border cells have neighbours outside of the tile
+                const std::size_t step = y == tile.min_y || y + 1 == tile.max_y ? 1 : std::max<std::size_t>(1, tile.max_x - tile.min_x - 1);
+                for (std::size_t x = tile.min_x; x < tile.max_x; x += step) {
+                    if (map(x, y) == CellType::obstacle) {
+                        continue;
+                    }
+                    for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                        std::size_t direction = lowest_bit(successors);
+                        std::size_t nx = x + directions[direction].dx, ny = y + directions[direction].dy;
+                        std::size_t neighbour = ny * width + nx;
+                        if (!tile.contains(nx, ny) && reached[neighbour]) {
+                            update(y * width + x, distances[neighbour] + MoveRules::exact_cost(direction), direction);
+                        }
+                    }
+                }
+            }
+
+            bool border_changed = false;
+            while (!queue.empty()) {
+                Entry entry = queue.top();
+                queue.pop();
+                if (entry.distance != distances[entry.cell]) {
+                    continue;
+                }
+                std::size_t x = entry.cell % width, y = entry.cell / width;
+                border_changed = border_changed || tile.on_border(x, y);
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t nx = x + directions[direction].dx, ny = y + directions[direction].dy;
+                    if (tile.contains(nx, ny)) {
+                        update(ny * width + nx, entry.distance + MoveRules::exact_cost(direction), opposite(direction));
+                    }
+                }
+            }
+            return border_changed;
+        }
+    };
+}
+
+
+namespace planner {
+    DistanceField::DistanceField(const GridMap<>& map, const MoveRules& rules, Point goal, std::size_t thread_count, std::size_t tile_size) :
+        width(map.get_width()),
+        height(map.get_height()),
+        goal(goal),
+        distances(width * height, std::numeric_limits<double>::infinity()),
+        moves(width * height, no_move)
+    {
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (thread_count == 1 || tile_size == 0) {
+            tile_size = std::max(width, height);
+        }
+        if (goal.x >= width || goal.y >= height || map(goal.x, goal.y) == CellType::obstacle) {
+            return;
+        }
+
+        std::vector<number> exact(width * height);
+        std::vector<std::uint8_t> reached(width * height, 0);
+        const std::size_t columns = (width + tile_size - 1) / tile_size, rows = (height + tile_size - 1) / tile_size;
+        std::vector<std::uint8_t> active(columns * rows, 0), changed(columns * rows, 0);
+        active[goal.y / tile_size * columns + goal.x / tile_size] = 1;
+        std::vector<TileSearch> searches;
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            searches.emplace_back(map, rules, exact, reached, moves);
+        }
+
+        // tiles of the same color don't touch each other even by corners, so they are searched at the same time without conflicts,
+        // a tile is searched again, when a border cell of a neighbouring tile changes
+        std::vector<std::size_t> phase;
+        for (bool any_active = true; any_active;) {
+            for (std::size_t color = 0; color < 4; ++color) {
+                phase.clear();
+                for (std::size_t row = color / 2; row < rows; row += 2) {
+                    for (std::size_t column = color % 2; column < columns; column += 2) {
+                        if (active[row * columns + column]) {
+                            active[row * columns + column] = 0;
+                            phase.push_back(row * columns + column);
+                        }
+                    }
+                }
+                std::atomic<std::size_t> next{ 0 };
+                auto worker = [&](TileSearch& search) {
+                    for (std::size_t position = next++; position < phase.size(); position = next++) {
+                        const std::size_t tile = phase[position];
+                        const std::size_t min_x = tile % columns * tile_size, min_y = tile / columns * tile_size;
+                        changed[tile] = search.run({ min_x, min_y, std::min(min_x + tile_size, width), std::min(min_y + tile_size, height) }, goal);
+                    }
+                };
+                const std::size_t phase_threads = std::min(thread_count, phase.size());
+                std::vector<std::thread> threads;
+                for (std::size_t i = 1; i < phase_threads; ++i) {
+                    threads.emplace_back(worker, std::ref(searches[i]));
+                }
+                worker(searches[0]);
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+                for (std::size_t tile : phase) {
+                    if (!changed[tile]) {
+                        continue;
+                    }
+                    const std::size_t row = tile / columns, column = tile % columns;
+                    for (std::size_t r = row == 0 ? 0 : row - 1; r <= std::min(row + 1, rows - 1); ++r) {
+                        for (std::size_t c = column == 0 ? 0 : column - 1; c <= std::min(column + 1, columns - 1); ++c) {
+                            active[r * columns + c] |= static_cast<std::uint8_t>(r != row || c != column);
+                        }
+                    }
+                }
+            }
+            any_active = std::find(std::begin(active), std::end(active), 1) != std::end(active);
+        }
+
+        for (std::size_t cell = 0; cell < width * height; ++cell) {
+            if (reached[cell]) {
+                distances[cell] = evaluate(exact[cell]);
+            }
+        }
+    }
+
+    void DistanceField::save(std::ostream& output) const {
+        std::uint64_t header[4] = { width, height, goal.x, goal.y };
+        output.write(field_magic.data(), field_magic.size());
+        output.write(reinterpret_cast<const char*>(header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(distances.data()), static_cast<std::streamsize>(distances.size() * sizeof(double)));
+        output.write(reinterpret_cast<const char*>(moves.data()), static_cast<std::streamsize>(moves.size()));
+    }
+
+    std::optional<DistanceField> DistanceField::load(std::istream& input) {
+        std::array<char, 8> magic{};
+        std::uint64_t header[4] = { 0, 0, 0, 0 };
+        input.read(magic.data(), magic.size());
+        input.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!input || magic != field_magic || header[2] >= header[0] || header[3] >= header[1]) {
+            return std::nullopt;
+        }
+        // the size is checked against the rest of the stream before anything is allocated
+        constexpr std::uint64_t cell_size = sizeof(double) + sizeof(std::uint8_t);
+        if (header[1] > std::numeric_limits<std::uint64_t>::max() / cell_size / header[0]) {
+            return std::nullopt;
+        }
+        const auto position = input.tellg();
+        input.seekg(0, std::ios::end);
+        const auto stream_end = input.tellg();
+        input.seekg(position);
+        if (position < 0 || stream_end < position || static_cast<std::uint64_t>(stream_end - position) < header[0] * header[1] * cell_size || !input) {
+            return std::nullopt;
+        }
+        DistanceField field;
+        field.width = header[0];
+        field.height = header[1];
+        field.goal = { header[2], header[3] };
+        field.distances.resize(field.width * field.height);
+        field.moves.resize(field.width * field.height);
+        input.read(reinterpret_cast<char*>(field.distances.data()), static_cast<std::streamsize>(field.distances.size() * sizeof(double)));
+        input.read(reinterpret_cast<char*>(field.moves.data()), static_cast<std::streamsize>(field.moves.size()));
+        if (!input || std::any_of(std::begin(field.moves), std::end(field.moves), [](std::uint8_t move) { return move > no_move; })) {
+            return std::nullopt;
+        }
+        return field;
+    }
+}
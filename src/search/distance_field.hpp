@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Shortest path distances from every cell to a goal and the flow field: the first move of a shortest path to the goal from every cell,
+    /// so any number of agents reach the goal by following moves, one lookup per step
+    /// computed by a Dijkstra search backward from the goal over a bucket queue with exact distances of the form `a + b * sqrt(2)`,
+    /// moves of `MoveRules` are symmetric, so distances to the goal equal distances from it
+    class DistanceField {
+    public:
+        static constexpr std::uint8_t no_move = 8;
+    private:
+        std::size_t width = 0;
+        std::size_t height = 0;
+        Point goal{};
+        std::vector<double> distances;  // infinite for obstacles and cells, which can't reach the goal
+        std::vector<std::uint8_t> moves;  // `no_move` for the goal and cells, which can't reach it
+    public:
+        /// with several threads the map is split into square tiles of `tile_size` cells, which are searched in parallel
+        /// and repeatedly, from distances of cells around them, until no distance on a tile border changes,
+        /// `thread_count` 0 means one thread per hardware thread
+        /// moves of cells with several shortest paths may differ between single and multithreaded fields
+        DistanceField(const GridMap<>& map, const MoveRules& rules, Point goal, std::size_t thread_count = 1, std::size_t tile_size = 64);
+
+        [[nodiscard]] double distance(Point cell) const {
+            return distances[cell.y * width + cell.x];
+        }
+
+        /// direction of the first move of a shortest path to the goal, `no_move` at the goal and in unreachable cells
+        [[nodiscard]] std::size_t move(Point cell) const {
+            return moves[cell.y * width + cell.x];
+        }
+
+        /// the cell after the first move to the goal, or the cell itself, if there is no move
+        [[nodiscard]] Point next(Point cell) const {
+            std::size_t direction = move(cell);
+            if (direction == no_move) {
+                return cell;
+            }
+            return { cell.x + directions[direction].dx, cell.y + directions[direction].dy };
+        }
+
+        [[nodiscard]] Point get_goal() const {
+            return goal;
+        }
+
+        [[nodiscard]] std::size_t get_width() const {
+            return width;
+        }
+
+        [[nodiscard]] std::size_t get_height() const {
+            return height;
+        }
+
+        /// binary format in the native byte order: a header with the size and the goal, distances as doubles and moves as bytes in row order
+        void save(std::ostream& output) const;
+
+        /// returns nothing, if the stream does not contain a valid saved field, the stream must be seekable
+        [[nodiscard]] static std::optional<DistanceField> load(std::istream& input);
+
+    private:
+        DistanceField() = default;
+    };
+}
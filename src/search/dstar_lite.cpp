@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include "dstar_lite.hpp"
+
+namespace {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+}
+
+
+namespace planner {
+    DStarLite::DStarLite(const GridMap<CellType>& map, std::shared_ptr<Heuristic<Point>> heuristic, const Options& options, Point from, Point to) :
+        map(map),
+        heuristic(std::move(heuristic)),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        start(from),
+        last_start(from),
+        finish(to),
+        distances(map.get_width() * map.get_height(), infinity),
+        lookahead(map.get_width() * map.get_height(), infinity),
+        keys(map.get_width() * map.get_height()),
+        queue{ KeyComparator{ keys }, map.get_width() * map.get_height() },
+        state{}
+    {
+        lookahead[cell(finish)] = 0;
+        keys[cell(finish)] = calculate_key(cell(finish));
+        queue.push(cell(finish), cell(finish));
+    }
+
+    DStarLite::Key DStarLite::calculate_key(std::size_t cell) const {
+        double distance = std::min(distances[cell], lookahead[cell]);
+        return { distance + (*heuristic)(start, position(cell)) + key_modifier, distance };
+    }
+
+    void DStarLite::update_vertex(std::size_t cell) {
+        Point point = position(cell);
+        if (point == finish) {
+            return;
+        }
+        double best = infinity;
+        if (map(point.x, point.y) != CellType::obstacle) {
+            // moves are symmetric, so successors of a cell are also its predecessors
+            for (std::uint32_t successors = moves(map.neighbourhood(point.x, point.y)); successors != 0; successors &= successors - 1) {
+                std::size_t direction = lowest_bit(successors);
+                Point next{ point.x + directions[direction].dx, point.y + directions[direction].dy };
+                best = std::min(best, MoveRules::cost(direction) + distances[this->cell(next)]);
+            }
+        }
+        lookahead[cell] = best;
+        queue.erase(cell);
+        if (distances[cell] != lookahead[cell]) {
+            keys[cell] = calculate_key(cell);
+            queue.push(cell, cell);
+        }
+    }
+
+    void DStarLite::compute_shortest_path() {
+        const std::size_t start_cell = cell(start);
+        auto less = [](const Key& a, const Key& b) {
+            return a.primary < b.primary || (a.primary == b.primary && a.secondary < b.secondary);
+        };
+        auto update_neighbours = [&](const Point& point) {
+            for (std::uint32_t successors = moves(map.neighbourhood(point.x, point.y)); successors != 0; successors &= successors - 1) {
+                std::size_t direction = lowest_bit(successors);
+                update_vertex(cell({ point.x + directions[direction].dx, point.y + directions[direction].dy }));
+            }
+        };
+        while (!queue.empty()) {
+            std::size_t top = queue.top();
+            Key old_key = keys[top];
+            // the start key is not stored in `keys`, because the start itself may be queued with an older key
+            if (!less(old_key, calculate_key(start_cell)) && lookahead[start_cell] == distances[start_cell]) {
+                break;
+            }
+            Key new_key = calculate_key(top);
+            Point point = position(top);
+            if (less(old_key, new_key)) {
+                queue.erase(top);
+                keys[top] = new_key;
+                queue.push(top, top);
+                continue;
+            }
+            queue.pop();
+            state.closed_indices.push_back(state.nodes.emplace(point, std::min(distances[top], lookahead[top]), (*heuristic)(start, point)));
+            if (distances[top] > lookahead[top]) {
+                distances[top] = lookahead[top];
+                if (map(point.x, point.y) != CellType::obstacle) {
+                    update_neighbours(point);
+                }
+            } else {
+                distances[top] = infinity;
+                if (map(point.x, point.y) != CellType::obstacle) {
+                    update_neighbours(point);
+                }
+                update_vertex(top);
+            }
+        }
+    }
+
+    const SearchState& DStarLite::plan() {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        state.reset();
+
+        compute_shortest_path();
+
+        const std::size_t cell_count = map.get_width() * map.get_height();
+        if (distances[cell(start)] != infinity && map(start.x, start.y) != CellType::obstacle) {
+            state.path_found = true;
+            Point current = start;
+            double travelled = 0;
+            state.path_indices.push_back(state.nodes.emplace(current, 0, distances[cell(current)]));
+            while (!(current == finish) && state.path_indices.size() <= cell_count) {
+                std::size_t best_direction = directions.size();
+                double best = infinity;
+                for (std::uint32_t successors = moves(map.neighbourhood(current.x, current.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    double through = MoveRules::cost(direction) + distances[cell({ current.x + directions[direction].dx, current.y + directions[direction].dy })];
+                    if (through < best) {
+                        best = through;
+                        best_direction = direction;
+                    }
+                }
+                if (best_direction == directions.size()) {
+                    break;
+                }
+                travelled += MoveRules::cost(best_direction);
+                current = { current.x + directions[best_direction].dx, current.y + directions[best_direction].dy };
+                state.path_indices.push_back(state.nodes.emplace(current, travelled, distances[cell(current)], state.path_indices.back()));
+            }
+            if (!(current == finish)) {
+                state.path_found = false;
+                state.path_indices.clear();
+            }
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+        return state;
+    }
+
+    void DStarLite::move_start(Point from) {
+        start = from;
+        key_modifier += (*heuristic)(last_start, start);
+        last_start = start;
+    }
+
+    void DStarLite::update_cells(const std::vector<Point>& changed) {
+        for (const Point& point : changed) {
+            // the cell itself and every cell, which can move through it or past it diagonally
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    std::size_t x = point.x + dx;
+                    std::size_t y = point.y + dy;
+                    if (x < map.get_width() && y < map.get_height()) {
+                        update_vertex(cell({ x, y }));
+                    }
+                }
+            }
+        }
+    }
+}
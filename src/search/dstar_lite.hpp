@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "interface.hpp"
+#include "moves.hpp"
+#include "open_list.hpp"
+
+
+namespace planner {
+    /// Incremental planner (D* Lite), searches backward from the finish and keeps the search tree between plans:
+    /// after map cells change or the start moves, `plan()` repairs only the part of the tree affected by the change
+    /// the map is referenced, it is changed by the owner with `GridMap::set_cell`, changed cells are then passed to `update_cells`
+    /// heuristic weight is not used, so paths are always shortest for a consistent heuristic
+    class DStarLite {
+        struct Key {
+            double primary;
+            double secondary;
+        };
+
+        struct KeyComparator {
+            const std::vector<Key>& keys;
+
+            [[nodiscard]] bool operator () (std::size_t a, std::size_t b) const {
+                return keys[a].primary < keys[b].primary || (keys[a].primary == keys[b].primary && keys[a].secondary < keys[b].secondary);
+            }
+        };
+
+        const GridMap<CellType>& map;
+        std::shared_ptr<Heuristic<Point>> heuristic;
+        MoveRules moves;
+        Point start;
+        Point last_start;
+        Point finish;
+        double key_modifier = 0;
+        std::vector<double> distances;  // g
+        std::vector<double> lookahead;  // rhs, one step lookahead distance
+        std::vector<Key> keys;  // key of every queued cell
+        QuaternaryHeap<std::size_t, KeyComparator> queue;
+        SearchState state;
+
+        [[nodiscard]] std::size_t cell(const Point& point) const {
+            return point.y * map.get_width() + point.x;
+        }
+
+        [[nodiscard]] Point position(std::size_t cell) const {
+            return { cell % map.get_width(), cell / map.get_width() };
+        }
+
+        [[nodiscard]] Key calculate_key(std::size_t cell) const;
+        void update_vertex(std::size_t cell);
+        void compute_shortest_path();
+    public:
+        DStarLite(const GridMap<CellType>& map, std::shared_ptr<Heuristic<Point>> heuristic, const Options& options, Point from, Point to);
+
+        DStarLite(const DStarLite&) = delete;
+        DStarLite& operator = (const DStarLite&) = delete;
+
+        /// finds the shortest path from the current start, `closed` contains cells expanded by this call only
+        const SearchState& plan();
+
+        /// moves the start, for example after the agent made a step along the path
+        void move_start(Point from);
+
+        /// must be called after the cells have changed on the map
+        void update_cells(const std::vector<Point>& changed);
+    };
+}
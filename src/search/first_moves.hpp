@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Dijkstra search from one source, which keeps the set of first moves of all shortest paths to every cell,
+    /// used to precompute per source data of path databases and goal bounds
+    class FirstMoveSearch {
+        // paths of equal length may get slightly different sums of move costs, depending on the order of moves
+        static constexpr double tie_tolerance = 1e-7;
+
+        std::vector<double> distances;
+        std::vector<std::uint8_t> first_moves;
+        std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<>> queue;
+    public:
+        void run(const GridMap<>& map, const MoveRules& rules, std::size_t source) {
+            const std::size_t width = map.get_width();
+            distances.assign(width * map.get_height(), std::numeric_limits<double>::infinity());
+            first_moves.assign(distances.size(), 0);
+            distances[source] = 0;
+            queue.emplace(0, source);
+            // moves cost at least 1, so the set of a cell is complete, when the cell is taken from the queue
+            while (!queue.empty()) {
+                auto [distance, cell] = queue.top();
+                queue.pop();
+                if (distance > distances[cell]) {
+                    continue;
+                }
+                std::size_t x = cell % width, y = cell / width;
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t neighbour = (y + directions[direction].dy) * width + x + directions[direction].dx;
+                    double neighbour_distance = distance + MoveRules::cost(direction);
+                    std::uint8_t moves = cell == source ? static_cast<std::uint8_t>(1u << direction) : first_moves[cell];
+                    if (neighbour_distance < distances[neighbour] - tie_tolerance) {
+                        distances[neighbour] = neighbour_distance;
+                        first_moves[neighbour] = moves;
+                        queue.emplace(neighbour_distance, neighbour);
+                    } else if (neighbour_distance <= distances[neighbour] + tie_tolerance) {
+                        first_moves[neighbour] |= moves;
+                    }
+                }
+            }
+        }
+
+        /// first moves of shortest paths to the cell, none for the source and unreachable cells
+        [[nodiscard]] std::uint8_t moves(std::size_t cell) const {
+            return first_moves[cell];
+        }
+    };
+}
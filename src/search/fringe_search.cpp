@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include "fringe_search.hpp"
+#include "context.hpp"
+#include "float_comparison.hpp"
+#include "moves.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    /// Circular doubly linked list of cells through an extra head cell,
+    /// `links[2 * cell]` is the next cell and `links[2 * cell + 1]` is the previous one,
+    /// links of cells, which are not in the list, are never read, so the storage is not cleared between searches
+    class CellList {
+        std::vector<std::uint32_t>& links;
+        std::uint32_t head;
+    public:
+        CellList(std::vector<std::uint32_t>& links, std::size_t cell_count) : links(links), head(static_cast<std::uint32_t>(cell_count)) {
+            if (links.size() < 2 * (cell_count + 1)) {
+                links.resize(2 * (cell_count + 1));
+            }
+            links[2 * head] = head;
+            links[2 * head + 1] = head;
+        }
+
+        [[nodiscard]] std::uint32_t end() const {
+            return head;
+        }
+
+        [[nodiscard]] std::uint32_t first() const {
+            return links[2 * head];
+        }
+
+        [[nodiscard]] std::uint32_t next(std::uint32_t cell) const {
+            return links[2 * cell];
+        }
+
+        [[nodiscard]] bool empty() const {
+            return first() == head;
+        }
+
+        void insert_after(std::uint32_t position, std::uint32_t cell) {
+            std::uint32_t following = links[2 * position];
+            links[2 * cell] = following;
+            links[2 * cell + 1] = position;
+            links[2 * following + 1] = cell;
+            links[2 * position] = cell;
+        }
+
+        void erase(std::uint32_t cell) {
+            std::uint32_t previous = links[2 * cell + 1], following = links[2 * cell];
+            links[2 * previous] = following;
+            links[2 * following + 1] = previous;
+        }
+    };
+}
+
+
+namespace planner {
+    const SearchState& FringeSearch::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SearchState& state = context.state;
+        state.reset();
+        GridMemory& memory = context.memory;
+        const std::size_t width = map.get_width();
+        const std::size_t cell_count = width * map.get_height();
+        memory.reset(cell_count);
+        CellList fringe{ context.fringe, cell_count };
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        auto key = [width](const Point& point) { return static_cast<std::uint32_t>(point.y * width + point.x); };
+        auto cost = [this, &state](Node::index_type index) {
+            const Node& node = state.nodes[index];
+            return node.distance + options.heuristic_weight * node.estimation;
+        };
+        auto snapshot = [&]() {
+            std::vector<Node> result;
+            for (std::uint32_t cell = fringe.first(); cell != fringe.end(); cell = fringe.next(cell)) {
+                result.push_back(state.nodes[memory[cell].node]);
+            }
+            return result;
+        };
+
+        Node::index_type start = state.nodes.emplace(from, 0, (*heuristic)(from, to));
+        memory.open(key(from), start, 0);
+        fringe.insert_after(fringe.end(), key(from));
+        double threshold = cost(start);
+        Node::index_type goal = Node::none;
+        std::size_t iterations = 0;
+        while (goal == Node::none && !fringe.empty()) {
+            ++iterations;
+            double next_threshold = std::numeric_limits<double>::infinity();
+            for (std::uint32_t cell = fringe.first(); cell != fringe.end();) {
+                const Node::index_type current = memory[cell].node;
+                const double current_cost = cost(current);
+                if (very_close_greater(current_cost, threshold)) {
+                    next_threshold = std::min(next_threshold, current_cost);
+                    cell = fringe.next(cell);
+                    continue;
+                }
+                const Point position = state.nodes[current].position;
+                if (position == to) {
+                    goal = current;
+                    break;
+                }
+
+                const double distance = state.nodes[current].distance;
+                std::uint32_t last = cell;
+                for (std::uint32_t successors = rules(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    std::uint32_t neighbour = key(point);
+                    double neighbour_distance = distance + MoveRules::cost(direction);
+                    if (memory.visited(neighbour)) {
+                        if (!very_close_less(neighbour_distance, memory[neighbour].distance)) {
+                            continue;
+                        }
+                        if (memory.closed(neighbour)) {
+                            memory.reopen(neighbour);
+                        } else {
+                            fringe.erase(neighbour);
+                        }
+                        memory.relax(neighbour, neighbour_distance);
+                        Node& node = state.nodes[memory[neighbour].node];
+                        node.distance = neighbour_distance;
+                        node.parent = current;
+                    } else {
+                        memory.open(neighbour, state.nodes.emplace(point, neighbour_distance, (*heuristic)(point, to), current), neighbour_distance);
+                    }
+                    fringe.insert_after(last, neighbour);
+                    last = neighbour;
+                }
+
+                std::uint32_t following = fringe.next(cell);
+                fringe.erase(cell);
+                memory.close(cell);
+                state.closed_indices.push_back(current);
+                if (store_history) {
+                    state.open_history.push_back(snapshot());
+                    state.closed_history.push_back(state.closed_indices.size());
+                }
+                cell = following;
+            }
+            threshold = next_threshold;
+        }
+
+        if (goal != Node::none) {
+            state.path_found = true;
+            for (Node::index_type current = goal; current != Node::none; current = state.nodes[current].parent) {
+                state.path_indices.push_back(current);
+            }
+            std::reverse(std::begin(state.path_indices), std::end(state.path_indices));
+            state.closed_indices.push_back(goal);
+            for (std::uint32_t cell = fringe.first(); cell != fringe.end(); cell = fringe.next(cell)) {
+                if (cell != key(to)) {
+                    state.open_indices.push_back(memory[cell].node);
+                }
+            }
+        }
+        state.statistics["iterations"] = static_cast<double>(iterations);
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+        return state;
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "interface.hpp"
+
+
+namespace planner {
+    /// Fringe search: instead of a priority queue, open cells are kept in a list, which is scanned over and over,
+    /// every scan expands cells with `f` under the threshold and raises the threshold to the least `f` left above it
+    /// successors are inserted right after the expanded cell and are visited by the same scan
+    /// finds the same path lengths as `AStar` with a consistent heuristic, ties are broken by the list order
+    class FringeSearch : public Search {
+    public:
+        using Search::Search;
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "goal_bounding.hpp"
+#include "first_moves.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PLANNER_HAS_MMAP 1
+#endif
+
+
+namespace {
+    using namespace planner;
+
+    constexpr std::array<char, 8> bounds_magic = { 'G', 'O', 'A', 'L', 'B', 'O', 'X', '1' };
+
+    constexpr GoalBounds::Box empty_box = { 0xFFFFu, 0xFFFFu, 0, 0 };
+
+    /// magic, key, width and height
+    constexpr std::size_t header_size = bounds_magic.size() + 3 * sizeof(std::uint64_t);
+
+    bool valid_header(const char* header, std::uint64_t key, std::size_t width, std::size_t height) {
+        std::array<char, 8> magic{};
+        std::uint64_t values[3] = { 0, 0, 0 };
+        std::memcpy(magic.data(), header, magic.size());
+        std::memcpy(values, header + magic.size(), sizeof(values));
+        return magic == bounds_magic && values[0] == key && values[1] == width && values[2] == height;
+    }
+}
+
+
+namespace planner {
+    GoalBounds::GoalBounds(const GridMap<>& map, const MoveRules& rules, std::size_t thread_count) :
+        width(map.get_width()),
+        cell_count(map.get_width() * map.get_height()),
+        owned(cell_count * 8, empty_box)
+    {
+        if (map.get_width() > 0x10000u || map.get_height() > 0x10000u) {
+            throw std::logic_error{ "map is too large for goal bounds" };
+        }
+        boxes = owned.data();
+
+        std::vector<std::size_t> sources;
+        for (std::size_t cell = 0; cell < cell_count; ++cell) {
+            if (map(cell % width, cell / width) != CellType::obstacle) {
+                sources.push_back(cell);
+            }
+        }
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::max<std::size_t>(1, std::min(thread_count, sources.size()));
+        std::atomic<std::size_t> next{ 0 };
+        auto worker = [&]() {
+            FirstMoveSearch search;
+            for (std::size_t number = next++; number < sources.size(); number = next++) {
+                const std::size_t source = sources[number];
+                search.run(map, rules, source);
+                // every worker writes only the boxes of its own sources
+                Box* source_boxes = owned.data() + source * 8;
+                for (std::size_t target = 0; target < cell_count; ++target) {
+                    auto x = static_cast<std::uint16_t>(target % width), y = static_cast<std::uint16_t>(target / width);
+                    for (std::uint32_t moves = search.moves(target); moves != 0; moves &= moves - 1) {
+                        Box& box = source_boxes[lowest_bit(moves)];
+                        box.min_x = std::min(box.min_x, x);
+                        box.min_y = std::min(box.min_y, y);
+                        box.max_x = std::max(box.max_x, x);
+                        box.max_y = std::max(box.max_y, y);
+                    }
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void GoalBounds::save(std::ostream& output, std::uint64_t key) const {
+        std::uint64_t values[3] = { key, width, width == 0 ? 0 : cell_count / width };
+        output.write(bounds_magic.data(), bounds_magic.size());
+        output.write(reinterpret_cast<const char*>(values), sizeof(values));
+        output.write(reinterpret_cast<const char*>(boxes), static_cast<std::streamsize>(cell_count * 8 * sizeof(Box)));
+    }
+
+    std::optional<GoalBounds> GoalBounds::load(std::istream& input, std::uint64_t key, std::size_t width, std::size_t height) {
+        std::array<char, header_size> header{};
+        input.read(header.data(), header.size());
+        if (!input || !valid_header(header.data(), key, width, height)) {
+            return std::nullopt;
+        }
+        GoalBounds bounds;
+        bounds.width = width;
+        bounds.cell_count = width * height;
+        bounds.owned.resize(bounds.cell_count * 8);
+        input.read(reinterpret_cast<char*>(bounds.owned.data()), static_cast<std::streamsize>(bounds.owned.size() * sizeof(Box)));
+        if (!input) {
+            return std::nullopt;
+        }
+        bounds.boxes = bounds.owned.data();
+        return bounds;
+    }
+
+    std::optional<GoalBounds> GoalBounds::map_file(const std::string& filename, std::uint64_t key, std::size_t width, std::size_t height) {
+#ifdef PLANNER_HAS_MMAP
+        int descriptor = ::open(filename.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            return std::nullopt;
+        }
+        struct stat status{};
+        const std::size_t file_size = header_size + width * height * 8 * sizeof(Box);
+        if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) != file_size) {
+            ::close(descriptor);
+            return std::nullopt;
+        }
+        void* address = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        // the mapping stays valid after the descriptor is closed
+        ::close(descriptor);
+        if (address == MAP_FAILED) {
+            return std::nullopt;
+        }
+        std::shared_ptr<const void> mapping{ address, [file_size](const void* mapped) { ::munmap(const_cast<void*>(mapped), file_size); } };
+        const char* data = static_cast<const char*>(address);
+        if (!valid_header(data, key, width, height)) {
+            return std::nullopt;
+        }
+        GoalBounds bounds;
+        bounds.width = width;
+        bounds.cell_count = width * height;
+        bounds.mapping = std::move(mapping);
+        bounds.boxes = reinterpret_cast<const Box*>(data + header_size);
+        return bounds;
+#else
+        std::ifstream input{ filename, std::ios::binary };
+        if (!input) {
+            return std::nullopt;
+        }
+        return load(input, key, width, height);
+#endif
+    }
+
+    GoalBoundsCache::GoalBoundsCache(const Options& options, std::string cache_directory) :
+        options(options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        cache_directory(std::move(cache_directory)),
+        bounds{}
+    {}
+
+    std::shared_ptr<const GoalBounds> GoalBoundsCache::get(const GridMap<>& map) const {
+        return bounds.get(map, [&]() {
+            if (cache_directory.empty()) {
+                return std::make_shared<const GoalBounds>(map, moves);
+            }
+            SidecarFile file{ cache_directory, map, options.allow_diagonal, options.cut_corners, options.allow_squeeze, ".gb" };
+            if (auto mapped = GoalBounds::map_file(file.get_path(), file.get_key(), map.get_width(), map.get_height()); mapped) {
+                return std::make_shared<const GoalBounds>(std::move(*mapped));
+            }
+            auto built = std::make_shared<const GoalBounds>(map, moves);
+            file.save([&](std::ostream& output) { built->save(output, file.get_key()); });
+            return built;
+        });
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Goal bounds: for every free cell and every move from it, the bounding box of all cells,
+    /// which have a shortest path from the cell starting with the move (ties included),
+    /// so a search towards a goal outside of the box may skip the move without losing optimality
+    class GoalBounds {
+    public:
+        /// inclusive cell coordinates, an empty box has `min` above `max`
+        struct Box {
+            std::uint16_t min_x, min_y, max_x, max_y;
+        };
+    private:
+        std::size_t width = 0;
+        std::size_t cell_count = 0;
+        std::vector<Box> owned;
+        std::shared_ptr<const void> mapping;  // keeps a mapped file alive, when boxes are read from it
+        const Box* boxes = nullptr;  // indexed by `cell * 8 + direction`, points to `owned` or into the mapping
+    public:
+        /// boxes are built in parallel by `thread_count` threads, 0 means one per hardware thread
+        GoalBounds(const GridMap<>& map, const MoveRules& rules, std::size_t thread_count = 0);
+
+        GoalBounds(GoalBounds&&) = default;
+        GoalBounds& operator = (GoalBounds&&) = default;
+        GoalBounds(const GoalBounds&) = delete;
+        GoalBounds& operator = (const GoalBounds&) = delete;
+
+        /// moves from the cell, which may start a shortest path to `goal`, as a mask of directions
+        [[nodiscard]] std::uint8_t moves_towards(std::size_t cell, Point goal) const {
+            const Box* cell_boxes = boxes + cell * 8;
+            std::uint8_t result = 0;
+            for (std::size_t direction = 0; direction < 8; ++direction) {
+                const Box& box = cell_boxes[direction];
+                bool inside = box.min_x <= goal.x && goal.x <= box.max_x && box.min_y <= goal.y && goal.y <= box.max_y;
+                result |= static_cast<std::uint8_t>(inside << direction);
+            }
+            return result;
+        }
+
+        [[nodiscard]] const Box& box(std::size_t cell, std::size_t direction) const {
+            return boxes[cell * 8 + direction];
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return cell_count;
+        }
+
+        /// binary format in the native byte order, `key` identifies the map and move options the bounds were built for
+        void save(std::ostream& output, std::uint64_t key) const;
+
+        /// returns nothing, if the stream does not contain bounds of a `width` x `height` map saved with the same `key`
+        [[nodiscard]] static std::optional<GoalBounds> load(std::istream& input, std::uint64_t key, std::size_t width, std::size_t height);
+
+        /// like `load`, but boxes are mapped from the file into memory instead of being read,
+        /// on systems without `mmap` the file is read
+        [[nodiscard]] static std::optional<GoalBounds> map_file(const std::string& filename, std::uint64_t key, std::size_t width, std::size_t height);
+
+    private:
+        GoalBounds() = default;
+    };
+
+    /// Goal bounds of searches with the same move options,
+    /// built on the first search on a map and reused while the map is unchanged,
+    /// with non empty `cache_directory` they are also stored there and mapped into memory by later runs on the same map
+    class GoalBoundsCache {
+        Options options;
+        MoveRules moves;
+        std::string cache_directory;
+        MapCache<GoalBounds> bounds;
+    public:
+        GoalBoundsCache(const Options& options, std::string cache_directory);
+
+        [[nodiscard]] std::shared_ptr<const GoalBounds> get(const GridMap<>& map) const;
+    };
+}
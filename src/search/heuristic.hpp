@@ -1,50 +1,82 @@
 #pragma once
 #include <algorithm>
 #include <cmath>
+#include <optional>
+#include "../quadratic.hpp"
 
 
 namespace planner {
     template <typename Point>
     struct Heuristic {
         [[nodiscard]] virtual double operator ()(Point a, Point b) const = 0;
+
+        /// the same value without rounding, if the heuristic has one, used by searches with exact distances
+        [[nodiscard]] virtual std::optional<length> exact(Point /* a */, Point /* b */) const {
+            return std::nullopt;
+        }
+
         virtual ~Heuristic() = default;
     };
 
     // todo: decouple dependency on 2 component vector with fields `x`, `y`
     template <typename Point>
-    struct Diagonal : Heuristic<Point> {
+    struct Diagonal final : Heuristic<Point> {
         [[nodiscard]] double operator ()(Point a, Point b) const override {
             auto dx = std::max(a.x, b.x) - std::min(a.x, b.x);
             auto dy = std::max(a.y, b.y) - std::min(a.y, b.y);
             return static_cast<double>(std::max(dx, dy) - std::min(dx, dy)) + std::sqrt(2) * static_cast<double>(std::min(dx, dy));
         }
+
+        [[nodiscard]] std::optional<length> exact(Point a, Point b) const override {
+            auto dx = static_cast<int>(std::max(a.x, b.x) - std::min(a.x, b.x));
+            auto dy = static_cast<int>(std::max(a.y, b.y) - std::min(a.y, b.y));
+            return length{ number{ std::max(dx, dy) - std::min(dx, dy), std::min(dx, dy) } };
+        }
     };
 
     template <typename Point>
-    struct Manhattan : Heuristic<Point> {
+    struct Manhattan final : Heuristic<Point> {
         [[nodiscard]] double operator ()(Point a, Point b) const override {
             auto dx = std::max(a.x, b.x) - std::min(a.x, b.x);
             auto dy = std::max(a.y, b.y) - std::min(a.y, b.y);
             return dx + dy;
         }
+
+        [[nodiscard]] std::optional<length> exact(Point a, Point b) const override {
+            auto dx = static_cast<int>(std::max(a.x, b.x) - std::min(a.x, b.x));
+            auto dy = static_cast<int>(std::max(a.y, b.y) - std::min(a.y, b.y));
+            return length{ number{ dx + dy } };
+        }
     };
 
     template <typename Point>
-    struct Euclidean : Heuristic<Point> {
+    struct Euclidean final : Heuristic<Point> {
         [[nodiscard]] double operator ()(Point a, Point b) const override {
             auto dx = std::max(a.x, b.x) - std::min(a.x, b.x);
             auto dy = std::max(a.y, b.y) - std::min(a.y, b.y);
             return std::sqrt(dx * dx + dy * dy);
         }
+
+        [[nodiscard]] std::optional<length> exact(Point a, Point b) const override {
+            auto dx = static_cast<int>(std::max(a.x, b.x) - std::min(a.x, b.x));
+            auto dy = static_cast<int>(std::max(a.y, b.y) - std::min(a.y, b.y));
+            return length{ number{}, dx * dx + dy * dy };
+        }
     };
 
 
     template <typename Point>
-    struct Chebyshev : Heuristic<Point> {
+    struct Chebyshev final : Heuristic<Point> {
         [[nodiscard]] double operator ()(Point a, Point b) const override {
             auto dx = std::max(a.x, b.x) - std::min(a.x, b.x);
             auto dy = std::max(a.y, b.y) - std::min(a.y, b.y);
             return std::max(dx, dy);
         }
+
+        [[nodiscard]] std::optional<length> exact(Point a, Point b) const override {
+            auto dx = static_cast<int>(std::max(a.x, b.x) - std::min(a.x, b.x));
+            auto dy = static_cast<int>(std::max(a.y, b.y) - std::min(a.y, b.y));
+            return length{ number{ std::max(dx, dy) } };
+        }
     };
 }
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include "hpa_star.hpp"
+#include "search_space.hpp"
+
+namespace {
+    using namespace planner;
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // border runs of at least this length get a transition at both ends, shorter ones get a single transition in the middle
+    constexpr std::size_t long_entrance = 6;
+
+    /// Dijkstra search, which does not leave the cluster bounds
+    class ClusterSearch {
+        ClusterGraph::Bounds bounds{};
+        std::size_t cluster_width = 0;
+        std::vector<double> distances;
+        std::vector<std::uint8_t> parents;  // direction of the move, which reached the cell
+        std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<>> queue;
+
+        [[nodiscard]] std::size_t local(const Point& point) const {
+            return (point.y - bounds.top) * cluster_width + point.x - bounds.left;
+        }
+
+        [[nodiscard]] Point global(std::size_t local) const {
+            return { bounds.left + local % cluster_width, bounds.top + local / cluster_width };
+        }
+    public:
+        void run(const GridMap<>& map, const MoveRules& rules, const ClusterGraph::Bounds& cluster, Point source) {
+            bounds = cluster;
+            cluster_width = bounds.right - bounds.left;
+            distances.assign(cluster_width * (bounds.bottom - bounds.top), infinity);
+            parents.assign(distances.size(), 0);
+            distances[local(source)] = 0;
+            queue.emplace(0, local(source));
+            while (!queue.empty()) {
+                auto [distance, current] = queue.top();
+                queue.pop();
+                if (distance > distances[current]) {
+                    continue;
+                }
+                Point position = global(current);
+                for (std::uint32_t successors = rules(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point next{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    if (!bounds.contains(next)) {
+                        continue;
+                    }
+                    double next_distance = distance + MoveRules::cost(direction);
+                    if (next_distance < distances[local(next)]) {
+                        distances[local(next)] = next_distance;
+                        parents[local(next)] = static_cast<std::uint8_t>(direction);
+                        queue.emplace(next_distance, local(next));
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] double distance(const Point& point) const {
+            return distances[local(point)];
+        }
+
+        /// cells of the shortest path from the source to `target`, without the source
+        [[nodiscard]] std::vector<Point> path(Point target) const {
+            std::vector<Point> result;
+            while (distances[local(target)] != 0) {
+                result.push_back(target);
+                const Direction& direction = directions[parents[local(target)]];
+                target = { target.x - direction.dx, target.y - direction.dy };
+            }
+            std::reverse(std::begin(result), std::end(result));
+            return result;
+        }
+    };
+
+    std::uint64_t hash_cells(const GridMap<>& map, const ClusterGraph::Bounds& bounds) {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t y = bounds.top; y < bounds.bottom; ++y) {
+            for (std::size_t x = bounds.left; x < bounds.right; ++x) {
+                hash ^= static_cast<std::uint64_t>(map(x, y));
+                hash *= 1099511628211ull;
+            }
+        }
+        return hash;
+    }
+}
+
+
+namespace planner {
+    ClusterGraph::ClusterGraph(const GridMap<>& map, const MoveRules& rules, std::size_t cluster_size, const ClusterGraph* previous) :
+        width(map.get_width()),
+        height(map.get_height()),
+        cluster_size(cluster_size),
+        clusters_x(cluster_size == 0 ? 0 : (map.get_width() + cluster_size - 1) / cluster_size),
+        clusters_y(cluster_size == 0 ? 0 : (map.get_height() + cluster_size - 1) / cluster_size),
+        clusters(clusters_x * clusters_y)
+    {
+        if (cluster_size == 0) {
+            throw std::logic_error{ "cluster size must be positive" };
+        }
+        for (std::size_t index = 0; index < clusters.size(); ++index) {
+            clusters[index].hash = hash_cells(map, bounds(index));
+        }
+
+        bool reusable = previous != nullptr && previous->width == width && previous->height == height && previous->cluster_size == cluster_size;
+        std::vector<bool> dirty(clusters.size(), !reusable);
+        if (reusable) {
+            // transitions of a cluster depend on the cells of all clusters around it
+            for (std::size_t index = 0; index < clusters.size(); ++index) {
+                if (clusters[index].hash == previous->clusters[index].hash) {
+                    continue;
+                }
+                std::size_t cluster_x = index % clusters_x, cluster_y = index / clusters_x;
+                for (std::size_t y = cluster_y == 0 ? 0 : cluster_y - 1; y <= cluster_y + 1 && y < clusters_y; ++y) {
+                    for (std::size_t x = cluster_x == 0 ? 0 : cluster_x - 1; x <= cluster_x + 1 && x < clusters_x; ++x) {
+                        dirty[y * clusters_x + x] = true;
+                    }
+                }
+            }
+        }
+        for (std::size_t index = 0; index < clusters.size(); ++index) {
+            if (dirty[index]) {
+                build_cluster(map, rules, index);
+                ++rebuilt;
+            } else {
+                clusters[index] = previous->clusters[index];
+            }
+        }
+    }
+
+    ClusterGraph::Bounds ClusterGraph::bounds(std::size_t index) const {
+        std::size_t left = (index % clusters_x) * cluster_size;
+        std::size_t top = (index / clusters_x) * cluster_size;
+        return { left, top, std::min(left + cluster_size, width), std::min(top + cluster_size, height) };
+    }
+
+    std::size_t ClusterGraph::entrance_count() const {
+        std::size_t count = 0;
+        for (const auto& cluster : clusters) {
+            count += cluster.entrances.size();
+        }
+        return count;
+    }
+
+    void ClusterGraph::build_cluster(const GridMap<>& map, const MoveRules& rules, std::size_t index) {
+        Cluster& cluster = clusters[index];
+        cluster.entrances.clear();
+        cluster.transitions.clear();
+        const Bounds cluster_bounds = bounds(index);
+        auto key = [this](const Point& point) { return point.y * width + point.x; };
+
+        // runs of free cell pairs across a border, both neighbouring clusters walk the border in the same order
+        auto add_border = [&](std::size_t length, auto own, auto other) {
+            std::size_t run_start = 0;
+            for (std::size_t i = 0; i <= length; ++i) {
+                bool free = i < length && map(own(i).x, own(i).y) != CellType::obstacle && map(other(i).x, other(i).y) != CellType::obstacle;
+                if (free) {
+                    continue;
+                }
+                if (run_start < i) {
+                    std::vector<std::size_t> positions;
+                    if (i - run_start < long_entrance) {
+                        positions.push_back(run_start + (i - run_start) / 2);
+                    } else {
+                        positions = { run_start, i - 1 };
+                    }
+                    for (std::size_t position : positions) {
+                        cluster.transitions.push_back({ key(own(position)), key(other(position)), 1.0 });
+                    }
+                }
+                run_start = i + 1;
+            }
+        };
+        const std::size_t cluster_width = cluster_bounds.right - cluster_bounds.left;
+        const std::size_t cluster_height = cluster_bounds.bottom - cluster_bounds.top;
+        if (cluster_bounds.left > 0) {
+            add_border(cluster_height,
+                [&](std::size_t i) { return Point{ cluster_bounds.left, cluster_bounds.top + i }; },
+                [&](std::size_t i) { return Point{ cluster_bounds.left - 1, cluster_bounds.top + i }; });
+        }
+        if (cluster_bounds.right < width) {
+            add_border(cluster_height,
+                [&](std::size_t i) { return Point{ cluster_bounds.right - 1, cluster_bounds.top + i }; },
+                [&](std::size_t i) { return Point{ cluster_bounds.right, cluster_bounds.top + i }; });
+        }
+        if (cluster_bounds.top > 0) {
+            add_border(cluster_width,
+                [&](std::size_t i) { return Point{ cluster_bounds.left + i, cluster_bounds.top }; },
+                [&](std::size_t i) { return Point{ cluster_bounds.left + i, cluster_bounds.top - 1 }; });
+        }
+        if (cluster_bounds.bottom < height) {
+            add_border(cluster_width,
+                [&](std::size_t i) { return Point{ cluster_bounds.left + i, cluster_bounds.bottom - 1 }; },
+                [&](std::size_t i) { return Point{ cluster_bounds.left + i, cluster_bounds.bottom }; });
+        }
+
+        // a diagonal move between two blocked cells crosses the border without a free pair next to it, it gets its own transition
+        for (std::size_t y = cluster_bounds.top; y < cluster_bounds.bottom; ++y) {
+            for (std::size_t x = cluster_bounds.left; x < cluster_bounds.right; ++x) {
+                bool on_border = x == cluster_bounds.left || x + 1 == cluster_bounds.right || y == cluster_bounds.top || y + 1 == cluster_bounds.bottom;
+                if (!on_border || map(x, y) == CellType::obstacle) {
+                    continue;
+                }
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)) & 0b01010101u; successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point next{ x + directions[direction].dx, y + directions[direction].dy };
+                    if (!cluster_bounds.contains(next) &&
+                        map(next.x, y) == CellType::obstacle && map(x, next.y) == CellType::obstacle) {
+                        cluster.transitions.push_back({ key({ x, y }), key(next), MoveRules::cost(direction) });
+                    }
+                }
+            }
+        }
+
+        for (const auto& transition : cluster.transitions) {
+            cluster.entrances.push_back(transition.from);
+        }
+        std::sort(std::begin(cluster.entrances), std::end(cluster.entrances));
+        cluster.entrances.erase(std::unique(std::begin(cluster.entrances), std::end(cluster.entrances)), std::end(cluster.entrances));
+
+        const std::size_t count = cluster.entrances.size();
+        cluster.distances.assign(count * count, infinity);
+        ClusterSearch search;
+        for (std::size_t i = 0; i < count; ++i) {
+            search.run(map, rules, cluster_bounds, { cluster.entrances[i] % width, cluster.entrances[i] / width });
+            for (std::size_t j = 0; j < count; ++j) {
+                cluster.distances[i * count + j] = search.distance({ cluster.entrances[j] % width, cluster.entrances[j] / width });
+            }
+        }
+    }
+
+    HPAStar::HPAStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::size_t cluster_size) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        cluster_size(cluster_size),
+        graphs{}
+    {
+        if (cluster_size == 0) {
+            throw std::logic_error{ "cluster size must be positive" };
+        }
+    }
+
+    std::shared_ptr<const ClusterGraph> HPAStar::graph(const GridMap<CellType>& map) const {
+        return graphs.get_incremental(map, [&](const ClusterGraph* previous) {
+            return std::make_shared<const ClusterGraph>(map, moves, cluster_size, previous);
+        });
+    }
+
+    const SearchState& HPAStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto abstract_graph = graph(map);
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const ClusterGraph& clusters = *abstract_graph;
+        const std::size_t width = map.get_width();
+        auto position = [width](std::size_t cell) { return Point{ cell % width, cell / width }; };
+
+        // distances from the start to its cluster entrances and from the finish to its cluster entrances
+        const std::size_t start_cluster = clusters.cluster_of(from);
+        const std::size_t finish_cluster = clusters.cluster_of(to);
+        ClusterSearch start_search, finish_search;
+        start_search.run(map, moves, clusters.bounds(start_cluster), from);
+        finish_search.run(map, moves, clusters.bounds(finish_cluster), to);
+
+        return dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+            SearchState& state = best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Point point = search_space.nodes[optimal].position;
+                const double distance = search_space.nodes[optimal].distance;
+                if (point == from) {
+                    for (std::size_t entrance : clusters.cluster(start_cluster).entrances) {
+                        double local = start_search.distance(position(entrance));
+                        if (local != infinity) {
+                            search_space.reach(position(entrance), distance + local, optimal, estimate);
+                        }
+                    }
+                    if (start_cluster == finish_cluster && start_search.distance(to) != infinity) {
+                        search_space.reach(to, distance + start_search.distance(to), optimal, estimate);
+                    }
+                }
+                const std::size_t cluster_index = clusters.cluster_of(point);
+                const auto& cluster = clusters.cluster(cluster_index);
+                const std::size_t cell = point.y * width + point.x;
+                auto entrance = std::lower_bound(std::begin(cluster.entrances), std::end(cluster.entrances), cell);
+                if (entrance == std::end(cluster.entrances) || *entrance != cell) {
+                    return;
+                }
+                const std::size_t count = cluster.entrances.size();
+                const std::size_t row = static_cast<std::size_t>(entrance - std::begin(cluster.entrances));
+                for (std::size_t column = 0; column < count; ++column) {
+                    double local = cluster.distances[row * count + column];
+                    if (column != row && local != infinity) {
+                        search_space.reach(position(cluster.entrances[column]), distance + local, optimal, estimate);
+                    }
+                }
+                for (const auto& transition : cluster.transitions) {
+                    if (transition.from == cell) {
+                        search_space.reach(position(transition.to), distance + transition.cost, optimal, estimate);
+                    }
+                }
+                if (cluster_index == finish_cluster && finish_search.distance(point) != infinity) {
+                    search_space.reach(to, distance + finish_search.distance(point), optimal, estimate);
+                }
+            });
+
+            if (state.path_found) {
+                // every abstract edge is either a transition between neighbouring cells or a path inside a cluster
+                std::vector<NodeIndex> cells{ state.path_indices.front() };
+                ClusterSearch segment_search;
+                for (std::size_t i = 1; i < state.path_indices.size(); ++i) {
+                    const Point source = state.nodes[cells.back()].position;
+                    const Point target = state.nodes[state.path_indices[i]].position;
+                    std::size_t source_cluster = clusters.cluster_of(source);
+                    if (source_cluster != clusters.cluster_of(target)) {
+                        cells.push_back(state.path_indices[i]);
+                        continue;
+                    }
+                    segment_search.run(map, moves, clusters.bounds(source_cluster), source);
+                    auto segment = segment_search.path(target);
+                    for (std::size_t j = 0; j + 1 < segment.size(); ++j) {
+                        double step_distance = state.nodes[cells.back()].distance + MoveRules::cost(direction_between(state.nodes[cells.back()].position, segment[j]));
+                        cells.push_back(state.nodes.emplace(segment[j], step_distance, estimate(segment[j]), cells.back()));
+                    }
+                    cells.push_back(state.path_indices[i]);
+                }
+                state.path_indices = std::move(cells);
+            }
+            state.statistics["abstractnodes"] = static_cast<double>(clusters.entrance_count());
+            state.time_spent = std::chrono::high_resolution_clock::now() - start_time;
+            return state;
+        });
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Abstract graph of hierarchical search, the map is split into square clusters:
+    /// entrances are cells on cluster borders, connected to cells of neighbouring clusters by transitions,
+    /// and to other entrances of their cluster by the shortest paths, which do not leave the cluster
+    class ClusterGraph {
+    public:
+        struct Bounds {
+            std::size_t left;
+            std::size_t top;
+            std::size_t right;  // exclusive
+            std::size_t bottom;  // exclusive
+
+            [[nodiscard]] bool contains(const Point& point) const {
+                return left <= point.x && point.x < right && top <= point.y && point.y < bottom;
+            }
+        };
+
+        struct Transition {
+            std::size_t from;  // entrance cell of the cluster
+            std::size_t to;  // cell of another cluster
+            double cost;
+        };
+
+        struct Cluster {
+            std::uint64_t hash;  // of the cluster cells
+            std::vector<std::size_t> entrances;  // sorted cells
+            std::vector<Transition> transitions;
+            std::vector<double> distances;  // between every two entrances inside the cluster, infinity if not connected
+        };
+    private:
+        std::size_t width;
+        std::size_t height;
+        std::size_t cluster_size;
+        std::size_t clusters_x;
+        std::size_t clusters_y;
+        std::vector<Cluster> clusters;
+        std::size_t rebuilt = 0;
+
+        void build_cluster(const GridMap<>& map, const MoveRules& rules, std::size_t index);
+    public:
+        /// clusters of `previous`, whose cells and neighbour cells have not changed, are reused instead of being built
+        ClusterGraph(const GridMap<>& map, const MoveRules& rules, std::size_t cluster_size, const ClusterGraph* previous = nullptr);
+
+        [[nodiscard]] std::size_t cluster_of(const Point& point) const {
+            return (point.y / cluster_size) * clusters_x + point.x / cluster_size;
+        }
+
+        [[nodiscard]] Bounds bounds(std::size_t index) const;
+
+        [[nodiscard]] const Cluster& cluster(std::size_t index) const {
+            return clusters[index];
+        }
+
+        [[nodiscard]] std::size_t cluster_count() const {
+            return clusters.size();
+        }
+
+        [[nodiscard]] std::size_t entrance_count() const;
+
+        /// number of clusters built by the constructor, the others were reused
+        [[nodiscard]] std::size_t rebuilt_clusters() const {
+            return rebuilt;
+        }
+    };
+
+    /// Hierarchical path-finding A* (HPA*): searches the abstract graph, connecting the start and the finish
+    /// to the entrances of their clusters, then refines every abstract edge by a search inside its cluster
+    /// paths are close to, but not always, the shortest ones
+    /// the abstract graph is built by the first search on a map, is not included in the search time,
+    /// and after map changes only the clusters around changed cells are rebuilt
+    class HPAStar : public Search {
+        MoveRules moves;
+        std::size_t cluster_size;
+        MapCache<ClusterGraph> graphs;
+    public:
+        HPAStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::size_t cluster_size = 16);
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+
+        [[nodiscard]] std::shared_ptr<const ClusterGraph> graph(const GridMap<CellType>& map) const;
+    };
+}
@@ -1,31 +1,68 @@
+#include <stdexcept>
+#include <utility>
+#include "context.hpp"
 #include "float_comparison.hpp"
 #include "interface.hpp"
+#include "landmarks.hpp"
 
 
 namespace planner {
+    std::ostream& operator << (std::ostream& out, OpenListType type) {
+        switch (type) {
+            case OpenListType::set:
+                return out << "set";
+            case OpenListType::binary_heap:
+                return out << "binary-heap";
+            case OpenListType::quaternary_heap:
+                return out << "heap";
+        }
+        return out;
+    }
+
     std::ostream& operator << (std::ostream& out, const Options& options) {
         return out << "Options{ " <<
                    options.heuristic_weight << ", " <<
                    options.allow_diagonal << ", " <<
                    options.cut_corners << ", " <<
-                   options.allow_squeeze << " }";
+                   options.allow_squeeze << ", " <<
+                   options.open_list << ", " <<
+                   options.exact_distances << ", " <<
+                   options.goal_bounding << " }";
     }
 
-    Node::Node(Point position, double distance, double estimation, std::shared_ptr<Node> expanded_from)  :
+    Node::Node(Point position, double distance, double estimation, index_type parent)  :
         position(position),
         distance(distance),
         estimation(estimation),
-        expanded_from(std::move(expanded_from))
+        parent(parent)
     {}
 
     std::ostream& operator << (std::ostream& out, const Node& node) {
         out << "Node{ " << node.position << ", " << node.distance << ", " << node.estimation;
-        if (node.expanded_from != nullptr) {
-            out << ", " << node.expanded_from->position;
+        if (node.parent != Node::none) {
+            out << ", " << node.parent;
         }
         return out << " }";
     }
 
+    NodeArena::index_type NodeArena::emplace(Point position, double distance, double estimation, index_type parent) {
+        if (nodes.size() >= Node::none) {
+            throw std::length_error{ "node arena is exhausted" };
+        }
+        nodes.emplace_back(position, distance, estimation, parent);
+        return static_cast<index_type>(nodes.size() - 1);
+    }
+
+    NodeView::NodeView(const NodeArena& arena, const std::vector<index_type>& indices, std::size_t count) :
+        arena(arena),
+        first(indices.data()),
+        last(indices.data() + count)
+    {}
+
+    NodeView::NodeView(const NodeArena& arena, const std::vector<index_type>& indices) :
+        NodeView(arena, indices, indices.size())
+    {}
+
     Search::Search(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options) :
         heuristic(std::move(heuristic)),
         tie_breaker(std::move(tie_breaker)),
@@ -36,6 +73,12 @@ namespace planner {
         return heuristic;
     }
 
+    void Search::check_heuristic(const GridMap<CellType>& map) const {
+        if (auto landmarks = dynamic_cast<const LandmarkHeuristic<Point>*>(heuristic.get()); landmarks != nullptr && !landmarks->table->built_for(map)) {
+            throw std::logic_error{ "landmark table was built for another map or before its cells changed" };
+        }
+    }
+
     const std::shared_ptr<TieBreaker>& Search::get_tie_breaker() const {
         return tie_breaker;
     }
@@ -44,14 +87,44 @@ namespace planner {
         return options;
     }
 
+    SearchState Search::search(Point from, Point to, const GridMap<CellType>& map, bool store_history) const {
+        SearchContext context;
+        search(from, to, map, context, store_history);
+        return std::move(context.state);
+    }
+
+    NodeView SearchState::path() const {
+        return { nodes, path_indices };
+    }
+
+    NodeView SearchState::open() const {
+        return { nodes, open_indices };
+    }
+
+    NodeView SearchState::closed() const {
+        return { nodes, closed_indices };
+    }
+
+    void SearchState::reset() {
+        path_found = false;
+        nodes.reset();
+        path_indices.clear();
+        open_indices.clear();
+        closed_indices.clear();
+        time_spent = {};
+        statistics.clear();
+        open_history.clear();
+        closed_history.clear();
+    }
+
     double SearchState::path_length() const {
-        if (path.empty()) {  // todo: is this necessary?
+        if (path_indices.empty()) {  // todo: is this necessary?
             return 0.0;
         }
         double result = 0.0;
         Euclidean<Point> metric;
-        for (auto it = std::next(std::begin(path)); it != std::end(path); ++it) {
-            result += metric((*it)->position, (*it)->expanded_from->position);
+        for (auto it = std::next(std::begin(path_indices)); it != std::end(path_indices); ++it) {
+            result += metric(nodes[*it].position, nodes[*std::prev(it)].position);
         }
         return result;
     }
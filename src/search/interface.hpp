@@ -1,52 +1,206 @@
 #pragma once
 #include <chrono>
-#include <list>
-#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
 #include "heuristic.hpp"
+#include "node.hpp"
 #include "tiebreaker.hpp"
 #include "../map.hpp"  // todo: figure out how to remove relative location dependency
 
 
 namespace planner {
+    enum class OpenListType {
+        set,
+        binary_heap,
+        quaternary_heap,
+    };
+
+    std::ostream& operator << (std::ostream& out, OpenListType type);
+
     struct Options {
         double heuristic_weight;
         bool allow_diagonal;
         bool cut_corners;
         bool allow_squeeze;
+        OpenListType open_list = OpenListType::quaternary_heap;
+        bool exact_distances = false;  // keep distances as `a + b * sqrt(2)` and compare them without rounding
+        bool goal_bounding = false;  // skip moves, which can't start a shortest path to the goal, by precomputed goal bounds
 
         bool operator == (const Options& options) const {
             return heuristic_weight == options.heuristic_weight &&
                 allow_diagonal == options.allow_diagonal &&
                 cut_corners == options.cut_corners &&
-                allow_squeeze == options.allow_squeeze;
+                allow_squeeze == options.allow_squeeze &&
+                open_list == options.open_list &&
+                exact_distances == options.exact_distances &&
+                goal_bounding == options.goal_bounding;
         }
     };
 
     std::ostream& operator << (std::ostream& out, const Options& options);
 
-    struct Node {
-        Point position;
-        double distance;
-        double estimation;
-        std::shared_ptr<Node> expanded_from;
+    /// Contiguous per-search node storage, nodes refer to their parents by index
+    /// `reset()` drops all nodes in O(1), keeping allocated memory for the next search
+    class NodeArena {
+    public:
+        using index_type = Node::index_type;
+    private:
+        std::vector<Node> nodes;
+    public:
+        index_type emplace(Point position, double distance, double estimation, index_type parent = Node::none);
+
+        [[nodiscard]] Node& operator [](index_type index) {
+            return nodes[index];
+        }
+
+        [[nodiscard]] const Node& operator [](index_type index) const {
+            return nodes[index];
+        }
 
-        Node(Point position, double distance, double estimation, std::shared_ptr<Node> expanded_from = nullptr);
+        [[nodiscard]] std::size_t size() const {
+            return nodes.size();
+        }
+
+        void reserve(std::size_t capacity) {
+            nodes.reserve(capacity);
+        }
+
+        void reset() {
+            nodes.clear();
+        }
     };
 
-    std::ostream& operator << (std::ostream& out, const Node& node);
+    /// Read only sequence of arena nodes, given by their indices
+    class NodeView {
+    public:
+        using index_type = Node::index_type;
+
+        class iterator {
+            const NodeArena* arena;
+            const index_type* current;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Node;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Node*;
+            using reference = const Node&;
+
+            iterator(const NodeArena* arena, const index_type* current) : arena(arena), current(current) {}
+
+            reference operator * () const {
+                return (*arena)[*current];
+            }
+
+            pointer operator -> () const {
+                return &(*arena)[*current];
+            }
+
+            iterator& operator ++ () {
+                ++current;
+                return *this;
+            }
+
+            iterator operator ++ (int) {
+                iterator result = *this;
+                ++current;
+                return result;
+            }
+
+            bool operator == (const iterator& other) const {
+                return current == other.current;
+            }
+
+            bool operator != (const iterator& other) const {
+                return current != other.current;
+            }
+        };
+    private:
+        const NodeArena& arena;
+        const index_type* first;
+        const index_type* last;
+    public:
+        NodeView(const NodeArena& arena, const std::vector<index_type>& indices, std::size_t count);
+        NodeView(const NodeArena& arena, const std::vector<index_type>& indices);
+
+        [[nodiscard]] iterator begin() const {
+            return { &arena, first };
+        }
+
+        [[nodiscard]] iterator end() const {
+            return { &arena, last };
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return static_cast<std::size_t>(last - first);
+        }
+
+        [[nodiscard]] bool empty() const {
+            return first == last;
+        }
+
+        [[nodiscard]] const Node& operator [](std::size_t index) const {
+            return arena[first[index]];
+        }
+
+        [[nodiscard]] const Node& front() const {
+            return arena[*first];
+        }
+
+        [[nodiscard]] const Node& back() const {
+            return arena[*(last - 1)];
+        }
+    };
 
     struct SearchState {
-        bool path_found;
-        std::list<std::shared_ptr<Node>> path;
-        std::list<std::shared_ptr<Node>> open;
-        std::list<std::shared_ptr<Node>> closed;
-        std::chrono::high_resolution_clock::duration time_spent;
+        bool path_found = false;
+        NodeArena nodes;
+        std::vector<Node::index_type> path_indices;
+        std::vector<Node::index_type> open_indices;
+        std::vector<Node::index_type> closed_indices;
+        std::chrono::high_resolution_clock::duration time_spent{};
+        std::map<std::string, double> statistics;  // algorithm specific counters, written as summary attributes
 
-        std::list<std::list<std::shared_ptr<Node>>> open_history;  // todo: this is messy, move to explicit struct
-        std::list<std::list<std::shared_ptr<Node>>> closed_history;
+        std::vector<std::vector<Node>> open_history;  // open nodes after every step, copied, because open nodes are updated in place
+        std::vector<std::size_t> closed_history;  // closed list size after every step, closed nodes never change
+
+        [[nodiscard]] NodeView path() const;
+        [[nodiscard]] NodeView open() const;
+        [[nodiscard]] NodeView closed() const;
 
         [[nodiscard]] double path_length() const;
+
+        /// drops the result, keeping allocated memory for the next search
+        void reset();
+    };
+
+    /// Result of a one-to-many search: distances to requested targets, in the order of the request,
+    /// and shortest paths to them on demand
+    struct TargetDistances {
+        static constexpr std::uint8_t no_move = 8;
+
+        std::vector<double> distances;  // infinite for targets, which are unreachable or are not among the nearest ones
+        std::vector<std::size_t> order;  // numbers of found targets, from the nearest one
+        std::size_t expanded = 0;  // number of settled cells
+        std::chrono::high_resolution_clock::duration time_spent{};
+
+        Point start{};
+        std::vector<Point> targets;
+        std::size_t width = 0;
+        std::vector<std::uint8_t> moves;  // direction of the move into every cell on the search tree, `no_move` elsewhere
+
+        [[nodiscard]] bool found(std::size_t target) const {
+            return distances[target] != std::numeric_limits<double>::infinity();
+        }
+
+        /// cells of a shortest path from the start to the target, including both of them, empty if the target is not found
+        [[nodiscard]] std::vector<Point> path(std::size_t target) const;
     };
 
     struct LogOptions {
@@ -87,15 +241,18 @@ namespace planner {
         }
     };
 
-    // todo: refactor Search to accept heuristic, tie breaker and options as template parameters
-    // it may be hard or even impossible, because necessary types will be known only when the file is read
-    // which will happen at runtime
+    // heuristic and tie breaker types are known only at runtime, `dispatch_kernel` in search_space.hpp picks compiled kernels for common ones
+
+    class SearchContext;
 
     class Search {
     protected:
         std::shared_ptr<Heuristic<Point>> heuristic;
         std::shared_ptr<TieBreaker> tie_breaker;
         Options options;
+
+        /// throws, if the heuristic depends on precomputed map data, which was not built for `map` and its current cells
+        void check_heuristic(const GridMap<CellType>& map) const;
     public:
         Search(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options);
 
@@ -103,7 +260,16 @@ namespace planner {
         [[nodiscard]] const std::shared_ptr<TieBreaker>& get_tie_breaker() const;
         [[nodiscard]] const Options& get_options() const;
 
-        [[nodiscard]] virtual SearchState search(Point from, Point to, const GridMap<CellType>& map, bool store_history = false) const = 0;
+        /// searches with a fresh context, engines implement only the overload with a context
+        [[nodiscard]] SearchState search(Point from, Point to, const GridMap<CellType>& map, bool store_history = false) const;
+
+        /// searches reusing memory of `context`, the result is stored in the context and stays valid until its next search
+        virtual const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const = 0;
+
+        /// one Dijkstra search from `from` over moves allowed by options, which stops, when all `targets` are settled
+        /// or `nearest_count` of them are found, targets on obstacles or outside of the map are unreachable,
+        /// ties between the last found targets are broken arbitrarily
+        [[nodiscard]] virtual TargetDistances search_many(Point from, const std::vector<Point>& targets, const GridMap<CellType>& map, std::size_t nearest_count = std::numeric_limits<std::size_t>::max()) const;
 
         virtual ~Search() = default;
     };
@@ -0,0 +1,190 @@
+#include <limits>
+#include "jump_point.hpp"
+#include "search_space.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    constexpr double length_epsilon = 1e-9;
+
+    /// Shortest path lengths inside of the 3x3 block around a cell, from the block cell `source` to every other cell
+    /// cells of the block are indexed by `(dx + 1) + 3 * (dy + 1)`, the central cell is excluded from paths
+    std::array<double, 9> block_distances(std::uint8_t neighbourhood, int source_dx, int source_dy, bool allow_diagonal, bool cut_corners, bool allow_squeeze) {
+        auto index = [](int dx, int dy) { return static_cast<std::size_t>((dx + 1) + 3 * (dy + 1)); };
+        std::array<bool, 9> free{};
+        free[index(0, 0)] = true;
+        for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+            free[index(directions[direction].dx, directions[direction].dy)] = neighbourhood & (1u << direction);
+        }
+        auto can_move = [&](int x, int y, int dx, int dy) -> bool {
+            int tx = x + dx, ty = y + dy;
+            if (tx < -1 || tx > 1 || ty < -1 || ty > 1 || (tx == 0 && ty == 0) || !free[index(tx, ty)]) {
+                return false;
+            }
+            if (dx == 0 || dy == 0) {
+                return true;
+            }
+            if (!allow_diagonal) {
+                return false;
+            }
+            int free_components = free[index(x + dx, y)] + free[index(x, y + dy)];
+            return free_components == 2 || (free_components == 1 && cut_corners) || (free_components == 0 && cut_corners && allow_squeeze);
+        };
+
+        std::array<double, 9> distances;
+        distances.fill(std::numeric_limits<double>::infinity());
+        distances[index(source_dx, source_dy)] = 0;
+        std::array<bool, 9> done{};
+        while (true) {
+            std::size_t best = distances.size();
+            for (std::size_t i = 0; i < distances.size(); ++i) {
+                if (!done[i] && distances[i] < std::numeric_limits<double>::infinity() && (best == distances.size() || distances[i] < distances[best])) {
+                    best = i;
+                }
+            }
+            if (best == distances.size()) {
+                break;
+            }
+            done[best] = true;
+            int x = static_cast<int>(best % 3) - 1, y = static_cast<int>(best / 3) - 1;
+            for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+                int dx = directions[direction].dx, dy = directions[direction].dy;
+                if (can_move(x, y, dx, dy)) {
+                    std::size_t next = index(x + dx, y + dy);
+                    distances[next] = std::min(distances[next], distances[best] + MoveRules::cost(direction));
+                }
+            }
+        }
+        return distances;
+    }
+
+    std::size_t opposite(std::size_t direction) {
+        return (direction + directions.size() / 2) % directions.size();
+    }
+
+    std::uint8_t bit(std::size_t direction) {
+        return static_cast<std::uint8_t>(1u << direction);
+    }
+
+    class Jumper {
+        const GridMap<>& map;
+        const JumpRules& rules;
+        Point goal;
+    public:
+        Jumper(const GridMap<>& map, const JumpRules& rules, Point goal) : map(map), rules(rules), goal(goal) {}
+
+        /// makes moves in `direction` from `position`, until a jump point is found or the way is blocked
+        bool jump(Point& position, std::size_t direction, std::size_t& steps) const {
+            Point current = position;
+            steps = 0;
+            while (rules.get_moves()(map.neighbourhood(current.x, current.y)) & bit(direction)) {
+                current = { current.x + directions[direction].dx, current.y + directions[direction].dy };
+                ++steps;
+                if (current == goal) {
+                    position = current;
+                    return true;
+                }
+                std::uint8_t neighbourhood = map.neighbourhood(current.x, current.y);
+                if (rules.has_forced(direction, neighbourhood)) {
+                    position = current;
+                    return true;
+                }
+                std::uint8_t swept = rules.swept_directions(direction) & rules.successors(direction, neighbourhood);
+                for (; swept != 0; swept &= swept - 1) {
+                    Point side = current;
+                    std::size_t side_steps;
+                    if (jump(side, lowest_bit(swept), side_steps)) {
+                        position = current;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    };
+}
+
+
+namespace planner {
+    JumpRules::JumpRules(bool allow_diagonal, bool cut_corners, bool allow_squeeze) :
+        moves(allow_diagonal, cut_corners, allow_squeeze),
+        pruned{},
+        natural{},
+        swept{}
+    {
+        for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+            std::size_t back = opposite(direction);
+            bool is_horizontal = directions[direction].dy == 0;
+            for (std::size_t neighbourhood = 0; neighbourhood < 256; ++neighbourhood) {
+                auto mask = static_cast<std::uint8_t>(neighbourhood);
+                std::uint8_t legal = moves(mask) & ~bit(back);
+                std::uint8_t successors = 0;
+                if (!allow_diagonal && is_horizontal) {
+                    successors = legal;
+                } else {
+                    auto distances = block_distances(mask, directions[back].dx, directions[back].dy, allow_diagonal, cut_corners, allow_squeeze);
+                    double entry_cost = MoveRules::cost(direction);
+                    for (std::uint8_t candidates = legal; candidates != 0; candidates &= candidates - 1) {
+                        std::size_t next = lowest_bit(candidates);
+                        double through = entry_cost + MoveRules::cost(next);
+                        double around = distances[static_cast<std::size_t>((directions[next].dx + 1) + 3 * (directions[next].dy + 1))];
+                        bool is_pruned = MoveRules::is_diagonal(direction) ? around < through - length_epsilon : around <= through + length_epsilon;
+                        if (!is_pruned) {
+                            successors |= bit(next);
+                        }
+                    }
+                }
+                pruned[direction][neighbourhood] = successors;
+            }
+            natural[direction] = pruned[direction][0xFF];
+            if (allow_diagonal && MoveRules::is_diagonal(direction)) {
+                swept[direction] = bit((direction + 1) % directions.size()) | bit((direction + directions.size() - 1) % directions.size());
+            } else if (!allow_diagonal && is_horizontal) {
+                swept[direction] = bit(3) | bit(7);
+            }
+        }
+    }
+
+    JumpPoint::JumpPoint(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        rules(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        bounds(options.goal_bounding ? std::make_unique<GoalBoundsCache>(options, std::move(cache_directory)) : nullptr)
+    {}
+
+    const SearchState& JumpPoint::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto goal_bounds = bounds != nullptr ? bounds->get(map) : nullptr;
+        Jumper jumper{ map, rules, to };
+        auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+        SearchState& state = dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Node& node = search_space.nodes[optimal];
+                const Point position = node.position;
+                const double distance = node.distance;
+                std::uint8_t neighbourhood = map.neighbourhood(position.x, position.y);
+                std::uint8_t successors = node.parent == Node::none ?
+                    rules.get_moves()(neighbourhood) :
+                    rules.successors(direction_between(search_space.nodes[node.parent].position, position), neighbourhood);
+                // a shortest path through the jump point leaves it by a move, which starts a shortest path from it to the goal
+                if (goal_bounds != nullptr) {
+                    successors &= goal_bounds->moves_towards(position.y * map.get_width() + position.x, to);
+                }
+                for (; successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point = position;
+                    std::size_t steps;
+                    if (jumper.jump(point, direction, steps)) {
+                        search_space.reach(point, distance + static_cast<double>(steps) * MoveRules::cost(direction), optimal, estimate);
+                    }
+                }
+            });
+        });
+
+        if (state.path_found) {
+            unfold_path(state, estimate);
+        }
+        return state;
+    }
+}
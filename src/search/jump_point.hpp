@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "goal_bounding.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Jump point pruning rules for a combination of move options
+    /// `successors(direction, neighbourhood)` are neighbours of a cell entered by a move in `direction`,
+    /// which can't be reached from the previous cell avoiding the entered one by a path of the same length
+    /// (of smaller length for diagonal moves), computed over the 3x3 block around the cell
+    /// with straight moves only, vertical neighbours of horizontal moves are natural, so horizontal jumps sweep the grid
+    class JumpRules {
+        MoveRules moves;
+        std::array<std::array<std::uint8_t, 256>, 8> pruned;
+        std::array<std::uint8_t, 8> natural;
+        std::array<std::uint8_t, 8> swept;
+    public:
+        JumpRules(bool allow_diagonal, bool cut_corners, bool allow_squeeze);
+
+        [[nodiscard]] const MoveRules& get_moves() const {
+            return moves;
+        }
+
+        [[nodiscard]] std::uint8_t successors(std::size_t direction, std::uint8_t neighbourhood) const {
+            return pruned[direction][neighbourhood];
+        }
+
+        [[nodiscard]] bool has_forced(std::size_t direction, std::uint8_t neighbourhood) const {
+            return pruned[direction][neighbourhood] & ~natural[direction];
+        }
+
+        /// directions of straight jumps made from every cell of a jump in `direction`
+        [[nodiscard]] std::uint8_t swept_directions(std::size_t direction) const {
+            return swept[direction];
+        }
+    };
+
+    /// with `goal_bounding` jumps from a jump point are made only in directions, whose goal bounds contain the goal
+    class JumpPoint : public Search {
+        JumpRules rules;
+        std::unique_ptr<GoalBoundsCache> bounds;  // only with `goal_bounding`
+    public:
+        JumpPoint(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory = {});
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include "jump_point_plus.hpp"
+#include "search_space.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    constexpr std::array<char, 8> table_magic = { 'J', 'P', 'S', 'P', 'L', 'U', 'S', '1' };
+
+    std::uint8_t bit(std::size_t direction) {
+        return static_cast<std::uint8_t>(1u << direction);
+    }
+
+    int sign(std::ptrdiff_t value) {
+        return (value > 0) - (value < 0);
+    }
+
+    /// straight and horizontal (4-connected) jumps go first, since jumps sweeping the grid depend on them
+    std::array<std::size_t, 8> build_order(const JumpRules& rules) {
+        std::array<std::size_t, 8> order{};
+        std::size_t count = 0;
+        for (bool sweeping : { false, true }) {
+            for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+                if ((rules.swept_directions(direction) != 0) == sweeping) {
+                    order[count++] = direction;
+                }
+            }
+        }
+        return order;
+    }
+}
+
+
+namespace planner {
+    JumpTable::JumpTable(const GridMap<>& map, const JumpRules& rules) : distances(map.get_width() * map.get_height() * 8, 0) {
+        const std::size_t width = map.get_width(), height = map.get_height();
+        for (std::size_t direction : build_order(rules)) {
+            const int dx = directions[direction].dx, dy = directions[direction].dy;
+            // cells are visited against the direction, so the next cell of a jump is always computed before
+            for (std::size_t row = 0; row < height; ++row) {
+                std::size_t y = dy > 0 ? height - 1 - row : row;
+                for (std::size_t column = 0; column < width; ++column) {
+                    std::size_t x = dx > 0 ? width - 1 - column : column;
+                    if (!(rules.get_moves()(map.neighbourhood(x, y)) & bit(direction))) {
+                        continue;
+                    }
+                    std::size_t next_x = x + dx, next_y = y + dy;
+                    std::size_t next = next_y * width + next_x;
+                    std::uint8_t neighbourhood = map.neighbourhood(next_x, next_y);
+                    bool is_jump_point = rules.has_forced(direction, neighbourhood);
+                    std::uint8_t swept = rules.swept_directions(direction) & rules.successors(direction, neighbourhood);
+                    for (; swept != 0 && !is_jump_point; swept &= swept - 1) {
+                        is_jump_point = (*this)(next, lowest_bit(swept)) > 0;
+                    }
+                    std::int32_t next_distance = (*this)(next, direction);
+                    distances[(y * width + x) * 8 + direction] = is_jump_point ? 1 : next_distance > 0 ? next_distance + 1 : next_distance - 1;
+                }
+            }
+        }
+    }
+
+    void JumpTable::save(std::ostream& output, std::uint64_t key) const {
+        std::uint64_t count = distances.size();
+        output.write(table_magic.data(), table_magic.size());
+        output.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        output.write(reinterpret_cast<const char*>(distances.data()), static_cast<std::streamsize>(count * sizeof(std::int32_t)));
+    }
+
+    std::optional<JumpTable> JumpTable::load(std::istream& input, std::uint64_t key, std::size_t cell_count) {
+        std::array<char, 8> magic{};
+        std::uint64_t stored_key = 0, count = 0;
+        input.read(magic.data(), magic.size());
+        input.read(reinterpret_cast<char*>(&stored_key), sizeof(stored_key));
+        input.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!input || magic != table_magic || stored_key != key || count != cell_count * 8) {
+            return std::nullopt;
+        }
+        JumpTable table;
+        table.distances.resize(count);
+        input.read(reinterpret_cast<char*>(table.distances.data()), static_cast<std::streamsize>(count * sizeof(std::int32_t)));
+        if (!input) {
+            return std::nullopt;
+        }
+        return table;
+    }
+
+    JumpPointPlus::JumpPointPlus(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        rules(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        cache_directory(std::move(cache_directory)),
+        tables{}
+    {}
+
+    std::shared_ptr<const JumpTable> JumpPointPlus::table(const GridMap<CellType>& map) const {
+        return tables.get(map, [&]() {
+            if (cache_directory.empty()) {
+                return std::make_shared<const JumpTable>(map, rules);
+            }
+            SidecarFile file{ cache_directory, map, options.allow_diagonal, options.cut_corners, options.allow_squeeze, ".jps" };
+            if (std::ifstream input{ file.get_path(), std::ios::binary }; input) {
+                if (auto loaded = JumpTable::load(input, file.get_key(), map.get_width() * map.get_height()); loaded) {
+                    return std::make_shared<const JumpTable>(std::move(*loaded));
+                }
+            }
+            auto built = std::make_shared<const JumpTable>(map, rules);
+            file.save([&](std::ostream& output) { built->save(output, file.get_key()); });
+            return built;
+        });
+    }
+
+    const SearchState& JumpPointPlus::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto jumps = table(map);
+        auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+        const std::size_t width = map.get_width();
+        SearchState& state = dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Node& node = search_space.nodes[optimal];
+                const Point position = node.position;
+                const double distance = node.distance;
+                const auto goal_dx = static_cast<std::ptrdiff_t>(to.x) - static_cast<std::ptrdiff_t>(position.x);
+                const auto goal_dy = static_cast<std::ptrdiff_t>(to.y) - static_cast<std::ptrdiff_t>(position.y);
+                std::uint8_t neighbourhood = map.neighbourhood(position.x, position.y);
+                std::uint8_t successors = node.parent == Node::none ?
+                    rules.get_moves()(neighbourhood) :
+                    rules.successors(direction_between(search_space.nodes[node.parent].position, position), neighbourhood);
+                for (; successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    const int dx = directions[direction].dx, dy = directions[direction].dy;
+                    std::int32_t jump = (*jumps)(position.y * width + position.x, direction);
+                    // the table knows nothing about the goal, so a jump stops at the goal, if it lies on the jump,
+                    // or at the cell of the jump, from which a swept straight jump may reach the goal
+                    std::size_t goal_steps = 0;
+                    if (rules.swept_directions(direction) == 0) {
+                        if (goal_dx * dy == goal_dy * dx && sign(goal_dx) == dx && sign(goal_dy) == dy) {
+                            goal_steps = static_cast<std::size_t>(std::max(std::abs(goal_dx), std::abs(goal_dy)));
+                        }
+                    } else if (dy == 0) {
+                        if (sign(goal_dx) == dx) {
+                            goal_steps = static_cast<std::size_t>(std::abs(goal_dx));
+                        }
+                    } else if (sign(goal_dx) == dx && sign(goal_dy) == dy) {
+                        goal_steps = static_cast<std::size_t>(std::min(std::abs(goal_dx), std::abs(goal_dy)));
+                    }
+                    std::size_t steps = 0;
+                    if (goal_steps != 0 && goal_steps <= static_cast<std::size_t>(std::abs(jump))) {
+                        steps = goal_steps;
+                    } else if (jump > 0) {
+                        steps = static_cast<std::size_t>(jump);
+                    } else {
+                        continue;
+                    }
+                    Point point{ position.x + steps * dx, position.y + steps * dy };
+                    search_space.reach(point, distance + static_cast<double>(steps) * MoveRules::cost(direction), optimal, estimate);
+                }
+            });
+        });
+
+        if (state.path_found) {
+            unfold_path(state, estimate);
+        }
+        return state;
+    }
+}
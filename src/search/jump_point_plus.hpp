@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "jump_point.hpp"
+
+
+namespace planner {
+    /// Jump distances of every cell in every direction, precomputed for jump point search without a goal:
+    /// a positive distance is the number of steps to the next jump point,
+    /// otherwise its absolute value is the number of steps before the jump is blocked
+    class JumpTable {
+        std::vector<std::int32_t> distances;  // indexed by `cell * 8 + direction`
+    public:
+        JumpTable() = default;
+
+        JumpTable(const GridMap<>& map, const JumpRules& rules);
+
+        [[nodiscard]] std::int32_t operator ()(std::size_t cell, std::size_t direction) const {
+            return distances[cell * 8 + direction];
+        }
+
+        /// binary format in the native byte order, `key` identifies the map and move options the table was built for
+        void save(std::ostream& output, std::uint64_t key) const;
+
+        /// returns nothing, if the stream does not contain a table of `cell_count` cells saved with the same `key`
+        [[nodiscard]] static std::optional<JumpTable> load(std::istream& input, std::uint64_t key, std::size_t cell_count);
+    };
+
+    /// Jump point search over precomputed jump distances (JPS+),
+    /// tables are built on the first search on a map and reused while the map is unchanged,
+    /// with non empty `cache_directory` they are also stored there and loaded by later runs on the same map
+    class JumpPointPlus : public Search {
+        JumpRules rules;
+        std::string cache_directory;
+        MapCache<JumpTable> tables;
+    public:
+        JumpPointPlus(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory = {});
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+
+        [[nodiscard]] std::shared_ptr<const JumpTable> table(const GridMap<CellType>& map) const;
+    };
+}
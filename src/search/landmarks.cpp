@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+#include "landmarks.hpp"
+
+namespace {
+    using namespace planner;
+
+    constexpr std::size_t unreached = std::numeric_limits<std::size_t>::max();
+
+    // relative error of a distance rounded to float, twice the unit roundoff
+    constexpr double rounding_slack = 1.2e-7;
+
+    /// number of moves from the source to every cell
+    void count_moves(const GridMap<>& map, const MoveRules& rules, std::size_t source, std::vector<std::size_t>& moves) {
+        const std::size_t width = map.get_width();
+        moves.assign(width * map.get_height(), unreached);
+        std::vector<std::size_t> frontier{ source }, next;
+        moves[source] = 0;
+        for (std::size_t layer = 1; !frontier.empty(); ++layer) {
+            next.clear();
+            for (std::size_t cell : frontier) {
+                std::size_t x = cell % width, y = cell / width;
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t neighbour = (y + directions[direction].dy) * width + x + directions[direction].dx;
+                    if (moves[neighbour] == unreached) {
+                        moves[neighbour] = layer;
+                        next.push_back(neighbour);
+                    }
+                }
+            }
+            std::swap(frontier, next);
+        }
+    }
+
+    /// shortest path distances from the source, written to every `stride`-th element of `output`
+    void shortest_distances(const GridMap<>& map, const MoveRules& rules, std::size_t source, float* output, std::size_t stride) {
+        const std::size_t width = map.get_width();
+        std::vector<double> distances(width * map.get_height(), std::numeric_limits<double>::infinity());
+        std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<>> queue;
+        distances[source] = 0;
+        queue.emplace(0, source);
+        while (!queue.empty()) {
+            auto [distance, cell] = queue.top();
+            queue.pop();
+            if (distance > distances[cell]) {
+                continue;
+            }
+            std::size_t x = cell % width, y = cell / width;
+            for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                std::size_t direction = lowest_bit(successors);
+                std::size_t neighbour = (y + directions[direction].dy) * width + x + directions[direction].dx;
+                double neighbour_distance = distance + MoveRules::cost(direction);
+                if (neighbour_distance < distances[neighbour]) {
+                    distances[neighbour] = neighbour_distance;
+                    queue.emplace(neighbour_distance, neighbour);
+                }
+            }
+        }
+        for (std::size_t cell = 0; cell < distances.size(); ++cell) {
+            output[cell * stride] = std::isinf(distances[cell]) ? -1.0f : static_cast<float>(distances[cell]);
+        }
+    }
+}
+
+
+namespace planner {
+    LandmarkTable::LandmarkTable(const GridMap<>& map, const MoveRules& rules, std::size_t landmark_count, std::size_t thread_count) :
+        width(map.get_width()),
+        cell_count(map.get_width() * map.get_height()),
+        revision(map.get_revision())
+    {
+        // the free cell closest to the map centre is likely to be in its largest connected area
+        std::size_t seed = unreached;
+        double seed_distance = std::numeric_limits<double>::infinity();
+        for (std::size_t y = 0; y < map.get_height(); ++y) {
+            for (std::size_t x = 0; x < width; ++x) {
+                double dx = 2.0 * x - static_cast<double>(width), dy = 2.0 * y - static_cast<double>(map.get_height());
+                if (map(x, y) != CellType::obstacle && dx * dx + dy * dy < seed_distance) {
+                    seed = y * width + x;
+                    seed_distance = dx * dx + dy * dy;
+                }
+            }
+        }
+        if (seed == unreached) {
+            return;
+        }
+
+        // selection uses move counts, which are much cheaper than distances and are as good for finding far cells
+        std::vector<std::size_t> nearest, moves;
+        count_moves(map, rules, seed, nearest);
+        std::vector<std::size_t> cells;
+        while (cells.size() < landmark_count) {
+            std::size_t farthest = unreached;
+            for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                if (nearest[cell] != unreached && nearest[cell] > 0 && (farthest == unreached || nearest[cell] > nearest[farthest])) {
+                    farthest = cell;
+                }
+            }
+            if (farthest == unreached) {
+                break;
+            }
+            cells.push_back(farthest);
+            count_moves(map, rules, farthest, moves);
+            for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                nearest[cell] = std::min(nearest[cell], moves[cell]);
+            }
+        }
+        for (std::size_t cell : cells) {
+            landmarks.push_back({ cell % width, cell / width });
+        }
+
+        distances.resize(cell_count * cells.size());
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::min(thread_count, cells.size());
+        std::atomic<std::size_t> next{ 0 };
+        auto worker = [&]() {
+            for (std::size_t landmark = next++; landmark < cells.size(); landmark = next++) {
+                shortest_distances(map, rules, cells[landmark], distances.data() + landmark, cells.size());
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    double LandmarkTable::lower_bound(const Point& a, const Point& b) const {
+        std::size_t a_cell = a.y * width + a.x, b_cell = b.y * width + b.x;
+        if (a.x >= width || b.x >= width || a_cell >= cell_count || b_cell >= cell_count) {
+            return 0;
+        }
+        const std::size_t count = landmarks.size();
+        const float* a_distances = distances.data() + a_cell * count;
+        const float* b_distances = distances.data() + b_cell * count;
+        double result = 0;
+        for (std::size_t landmark = 0; landmark < count; ++landmark) {
+            double a_distance = a_distances[landmark], b_distance = b_distances[landmark];
+            if (a_distance >= 0 && b_distance >= 0) {
+                result = std::max(result, std::abs(a_distance - b_distance) - rounding_slack * (a_distance + b_distance));
+            }
+        }
+        return result;
+    }
+}
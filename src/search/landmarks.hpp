@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "heuristic.hpp"
+#include "moves.hpp"
+#include "../map.hpp"
+
+
+namespace planner {
+    /// Shortest path distances from a few landmark cells to every cell of a map,
+    /// landmarks are chosen by farthest point selection, so that they lie on the map periphery
+    class LandmarkTable {
+        std::size_t width = 0;
+        std::size_t cell_count = 0;
+        std::uint64_t revision = 0;  // of the map the table was built for
+        std::vector<Point> landmarks;
+        std::vector<float> distances;  // indexed by `cell * landmarks.size() + landmark`, negative for unreachable cells
+    public:
+        /// distances are computed in parallel by `thread_count` threads, 0 means one per hardware thread
+        LandmarkTable(const GridMap<>& map, const MoveRules& rules, std::size_t landmark_count, std::size_t thread_count = 0);
+
+        [[nodiscard]] const std::vector<Point>& get_landmarks() const {
+            return landmarks;
+        }
+
+        /// negative, if the cell can't be reached from the landmark
+        [[nodiscard]] float distance(std::size_t landmark, const Point& point) const {
+            return distances[(point.y * width + point.x) * landmarks.size() + landmark];
+        }
+
+        /// whether the table was built for the map and its current cells
+        [[nodiscard]] bool built_for(const GridMap<>& map) const {
+            return map.get_revision() == revision && map.get_width() == width && map.get_width() * map.get_height() == cell_count;
+        }
+
+        /// lower bound of the distance between two cells by the triangle inequality, 0 if the cells are not in the table
+        [[nodiscard]] double lower_bound(const Point& a, const Point& b) const;
+    };
+
+    /// Landmark (ALT) heuristic: the largest of the `base` heuristic and the landmark lower bound,
+    /// it is valid only for maps, which the table is `built_for`, searches check that before using it
+    template <typename Point>
+    struct LandmarkHeuristic : Heuristic<Point> {
+        std::shared_ptr<const LandmarkTable> table;
+        std::shared_ptr<Heuristic<Point>> base;
+
+        LandmarkHeuristic(std::shared_ptr<const LandmarkTable> table, std::shared_ptr<Heuristic<Point>> base) :
+            table(std::move(table)),
+            base(std::move(base))
+        {}
+
+        [[nodiscard]] double operator ()(Point a, Point b) const override {
+            return std::max((*base)(a, b), table->lower_bound(a, b));
+        }
+    };
+}
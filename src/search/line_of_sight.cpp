@@ -0,0 +1,46 @@
+#include <cstdint>
+#include <cstdlib>
+#include "line_of_sight.hpp"
+
+
+namespace planner {
+    LineOfSight::LineOfSight(bool allow_diagonal, bool cut_corners, bool allow_squeeze) :
+        cut_corners(allow_diagonal && cut_corners),
+        allow_squeeze(allow_diagonal && cut_corners && allow_squeeze)
+    {}
+
+    bool LineOfSight::operator ()(const GridMap<>& map, Point from, Point to) const {
+        // the segment crosses the i-th vertical cell border at `(2i + 1) / 2dx` of its length and the j-th horizontal one at `(2j + 1) / 2dy`,
+        // so crossings are ordered exactly in integers
+        const std::int64_t dx = std::llabs(static_cast<std::int64_t>(to.x) - static_cast<std::int64_t>(from.x));
+        const std::int64_t dy = std::llabs(static_cast<std::int64_t>(to.y) - static_cast<std::int64_t>(from.y));
+        const std::size_t step_x = to.x > from.x ? 1 : static_cast<std::size_t>(-1);
+        const std::size_t step_y = to.y > from.y ? 1 : static_cast<std::size_t>(-1);
+        auto is_free = [&map](std::size_t x, std::size_t y) { return map(x, y) != CellType::obstacle; };
+        std::size_t x = from.x, y = from.y;
+        std::int64_t i = 0, j = 0;
+        while (i < dx || j < dy) {
+            std::int64_t difference = j == dy ? -1 : i == dx ? 1 : (2 * i + 1) * dy - (2 * j + 1) * dx;
+            if (difference < 0) {
+                x += step_x;
+                ++i;
+            } else if (difference > 0) {
+                y += step_y;
+                ++j;
+            } else {
+                int free_sides = is_free(x + step_x, y) + is_free(x, y + step_y);
+                if ((free_sides == 1 && !cut_corners) || (free_sides == 0 && !allow_squeeze)) {
+                    return false;
+                }
+                x += step_x;
+                y += step_y;
+                ++i;
+                ++j;
+            }
+            if (!is_free(x, y)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "../map.hpp"
+
+
+namespace planner {
+    /// Visibility between cell centers, the segment must not cross obstacle cells,
+    /// passing exactly through a cell corner follows the corner rules of diagonal moves,
+    /// so neighbours are visible exactly when the move between them is allowed
+    class LineOfSight {
+        bool cut_corners;
+        bool allow_squeeze;
+    public:
+        LineOfSight(bool allow_diagonal, bool cut_corners, bool allow_squeeze);
+
+        [[nodiscard]] bool operator ()(const GridMap<>& map, Point from, Point to) const;
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "interface.hpp"
+
+
+namespace planner {
+    /// Dense per cell search records, indexed by `y * width + x`
+    /// every record is stamped with the generation of the search that wrote it, records with older stamps are absent,
+    /// so starting a new search is O(1) and the memory never has to be cleared between searches
+    class GridMemory {
+    public:
+        using stamp_type = std::uint32_t;
+
+        struct Record {
+            stamp_type stamp;  // `2 * generation` for open cells, `2 * generation + 1` for closed ones
+            Node::index_type node;
+            double distance;
+        };
+    private:
+        std::vector<Record> records;
+        stamp_type generation = 0;
+    public:
+        /// starts a new search over `cell_count` cells
+        void reset(std::size_t cell_count) {
+            if (records.size() != cell_count || generation == std::numeric_limits<stamp_type>::max() / 2) {
+                records.assign(cell_count, Record{ 0, Node::none, 0.0 });
+                generation = 0;
+            }
+            ++generation;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return records.size();
+        }
+
+        [[nodiscard]] bool visited(std::size_t cell) const {
+            return records[cell].stamp >= 2 * generation;
+        }
+
+        [[nodiscard]] bool closed(std::size_t cell) const {
+            return records[cell].stamp == 2 * generation + 1;
+        }
+
+        [[nodiscard]] const Record& operator [](std::size_t cell) const {
+            return records[cell];
+        }
+
+        void open(std::size_t cell, Node::index_type node, double distance) {
+            records[cell] = Record{ 2 * generation, node, distance };
+        }
+
+        void relax(std::size_t cell, double distance) {
+            records[cell].distance = distance;
+        }
+
+        void close(std::size_t cell) {
+            records[cell].stamp = 2 * generation + 1;
+        }
+
+        /// marks a closed cell as open again, keeping its node and distance
+        void reopen(std::size_t cell) {
+            records[cell].stamp = 2 * generation;
+        }
+    };
+}
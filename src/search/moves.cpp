@@ -0,0 +1,42 @@
+#include <stdexcept>
+#include "moves.hpp"
+
+
+namespace planner {
+    MoveRules::MoveRules(bool allow_diagonal, bool cut_corners, bool allow_squeeze) : successors{} {
+        for (std::size_t neighbourhood = 0; neighbourhood < successors.size(); ++neighbourhood) {
+            std::uint8_t mask = 0;
+            for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+                auto is_free = [neighbourhood](std::size_t i) -> bool { return neighbourhood & (1u << (i % directions.size())); };
+                if (!is_free(direction)) {
+                    continue;
+                }
+                if (is_diagonal(direction)) {
+                    if (!allow_diagonal) {
+                        continue;
+                    }
+                    std::size_t free_components = is_free(direction + 1) + is_free(direction + directions.size() - 1);
+                    if (free_components == 1 && !cut_corners) {
+                        continue;
+                    }
+                    if (free_components == 0 && (!cut_corners || !allow_squeeze)) {
+                        continue;
+                    }
+                }
+                mask |= static_cast<std::uint8_t>(1u << direction);
+            }
+            successors[neighbourhood] = mask;
+        }
+    }
+
+    std::size_t direction_between(Point from, Point to) {
+        int dx = (to.x > from.x) - (to.x < from.x);
+        int dy = (to.y > from.y) - (to.y < from.y);
+        for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+            if (directions[direction].dx == dx && directions[direction].dy == dy) {
+                return direction;
+            }
+        }
+        throw std::logic_error{ "points coincide, there is no direction between them" };
+    }
+}
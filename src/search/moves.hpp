@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "../map.hpp"
+#include "../quadratic.hpp"
+
+
+namespace planner {
+    /// Translates neighbourhood masks of `GridMap` cells to masks of allowed moves for a combination of move options
+    class MoveRules {
+        std::array<std::uint8_t, 256> successors;
+    public:
+        MoveRules(bool allow_diagonal, bool cut_corners, bool allow_squeeze);
+
+        [[nodiscard]] std::uint8_t operator ()(std::uint8_t neighbourhood) const {
+            return successors[neighbourhood];
+        }
+
+        [[nodiscard]] static constexpr bool is_diagonal(std::size_t direction) {
+            return direction % 2 == 0;
+        }
+
+        [[nodiscard]] static constexpr double cost(std::size_t direction) {
+            return is_diagonal(direction) ? Sqrt2<double>::value : 1.0;
+        }
+
+        [[nodiscard]] static number exact_cost(std::size_t direction) {
+            return is_diagonal(direction) ? number{ 0, 1 } : number{ 1, 0 };
+        }
+    };
+
+    /// Index of the direction from `from` towards `to`, which must lie on the same straight or diagonal line
+    std::size_t direction_between(Point from, Point to);
+
+    /// Index of the lowest set bit, `mask` must be non zero
+    inline std::size_t lowest_bit(std::uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+        std::size_t index = 0;
+        while (!(mask & 1u)) {
+            mask >>= 1u;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    /// Index of the lowest set bit of a 64 bit word, `mask` must be non zero
+    inline std::size_t lowest_bit_64(std::uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(mask));
+#else
+        std::size_t index = 0;
+        while (!(mask & 1u)) {
+            mask >>= 1u;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    /// Number of set bits of a 64 bit word
+    inline std::size_t bit_count_64(std::uint64_t mask) {
+        mask -= (mask >> 1u) & 0x5555555555555555ull;
+        mask = (mask & 0x3333333333333333ull) + ((mask >> 2u) & 0x3333333333333333ull);
+        mask = (mask + (mask >> 4u)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<std::size_t>((mask * 0x0101010101010101ull) >> 56u);
+    }
+}
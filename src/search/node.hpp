@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include "../map.hpp"
+#include "../quadratic.hpp"
+
+
+namespace planner {
+    struct Node {
+        using index_type = std::uint32_t;
+
+        static constexpr index_type none = std::numeric_limits<index_type>::max();
+
+        Point position;
+        double distance;
+        double estimation;
+        index_type parent;
+
+        Node(Point position, double distance, double estimation, index_type parent = none);
+    };
+
+    std::ostream& operator << (std::ostream& out, const Node& node);
+
+    /// Exact values of a node, kept next to the node arena by searches with exact distances
+    struct ExactCost {
+        number distance;
+        length estimation;
+        length cumulative;  // distance + heuristic weight * estimation
+    };
+}
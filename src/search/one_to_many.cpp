@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    TargetDistances Search::search_many(Point from, const std::vector<Point>& targets, const GridMap<CellType>& map, std::size_t nearest_count) const {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        const std::size_t width = map.get_width(), height = map.get_height();
+        auto is_free = [&](Point point) { return point.x < width && point.y < height && map(point.x, point.y) != CellType::obstacle; };
+
+        TargetDistances result;
+        result.distances.assign(targets.size(), std::numeric_limits<double>::infinity());
+        result.start = from;
+        result.targets = targets;
+        result.width = width;
+        result.moves.assign(width * height, TargetDistances::no_move);
+
+        // requested cells are sorted, so that targets of a settled cell are found by a binary search
+        std::vector<std::pair<std::size_t, std::size_t>> requested;
+        std::vector<bool> is_requested(width * height, false);
+        for (std::size_t target = 0; target < targets.size(); ++target) {
+            if (is_free(targets[target])) {
+                std::size_t cell = targets[target].y * width + targets[target].x;
+                requested.emplace_back(cell, target);
+                is_requested[cell] = true;
+            }
+        }
+        std::sort(std::begin(requested), std::end(requested));
+        nearest_count = std::min(nearest_count, requested.size());
+
+        if (is_free(from)) {
+            std::vector<double> distances(width * height, std::numeric_limits<double>::infinity());
+            std::priority_queue<std::pair<double, std::size_t>, std::vector<std::pair<double, std::size_t>>, std::greater<>> queue;
+            const std::size_t source = from.y * width + from.x;
+            distances[source] = 0;
+            queue.emplace(0, source);
+            while (!queue.empty() && result.order.size() < nearest_count) {
+                auto [distance, cell] = queue.top();
+                queue.pop();
+                if (distance > distances[cell]) {
+                    continue;
+                }
+                ++result.expanded;
+                if (is_requested[cell]) {
+                    auto first = std::lower_bound(std::begin(requested), std::end(requested), std::make_pair(cell, std::size_t{ 0 }));
+                    for (auto it = first; it != std::end(requested) && it->first == cell; ++it) {
+                        result.distances[it->second] = distance;
+                        result.order.push_back(it->second);
+                    }
+                }
+                std::size_t x = cell % width, y = cell / width;
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t neighbour = (y + directions[direction].dy) * width + x + directions[direction].dx;
+                    double neighbour_distance = distance + MoveRules::cost(direction);
+                    if (neighbour_distance < distances[neighbour]) {
+                        distances[neighbour] = neighbour_distance;
+                        result.moves[neighbour] = static_cast<std::uint8_t>(direction);
+                        queue.emplace(neighbour_distance, neighbour);
+                    }
+                }
+            }
+        }
+        result.time_spent = std::chrono::high_resolution_clock::now() - start_time;
+        return result;
+    }
+
+    std::vector<Point> TargetDistances::path(std::size_t target) const {
+        std::vector<Point> result;
+        if (!found(target)) {
+            return result;
+        }
+        // moves of settled cells are final, so the chain from a found target leads to the start
+        Point current = targets[target];
+        result.push_back(current);
+        while (!(current == start)) {
+            const auto& direction = directions[moves[current.y * width + current.x]];
+            current = { current.x - direction.dx, current.y - direction.dy };
+            result.push_back(current);
+        }
+        std::reverse(std::begin(result), std::end(result));
+        return result;
+    }
+}
@@ -0,0 +1,301 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace planner {
+    /// Open list contract shared by all implementations, which are used as template parameters:
+    /// every value is stored under a unique integer key (cell index of the node position)
+    /// `Compare` is a <less> comparator, `top()` returns the best value
+    /// `decrease()` invokes `modify`, which changes the ordering of the value stored under the key, and restores the order,
+    /// the value must not become worse (decrease-key)
+    /// `values()` returns a snapshot of stored values in unspecified order
+
+    /// Storage, which outlives open lists, so the next open list over the same keys starts without allocations
+    /// indexed heaps borrow their arrays from it and return them on destruction, the set doesn't use it
+    template <typename T>
+    struct OpenListBuffers {
+        std::vector<T> items;
+        std::vector<std::size_t> keys;
+        std::vector<std::size_t> slots;  // every slot is empty between open lists
+    };
+
+    /// Balanced search tree with a hash index, values must be strictly ordered by `Compare`
+    template <typename T, typename Compare>
+    class SetOpenList {
+    public:
+        using key_type = std::size_t;
+        using compare_type = Compare;
+    private:
+        struct EntryComparator {
+            Compare compare;
+
+            [[nodiscard]] bool operator () (const std::pair<T, key_type>& a, const std::pair<T, key_type>& b) const {
+                return compare(a.first, b.first);
+            }
+        };
+
+        using storage_type = std::set<std::pair<T, key_type>, EntryComparator>;
+
+        storage_type storage;
+        std::unordered_map<key_type, typename storage_type::const_iterator> index;
+    public:
+        SetOpenList(const Compare& compare, std::size_t /* key_count */) : storage{ EntryComparator{ compare } }, index{} {}
+        SetOpenList(const Compare& compare, std::size_t key_count, OpenListBuffers<T>& /* buffers */) : SetOpenList(compare, key_count) {}
+
+        [[nodiscard]] bool empty() const {
+            return storage.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return storage.size();
+        }
+
+        [[nodiscard]] const T& top() const {
+            return storage.begin()->first;
+        }
+
+        void pop() {
+            index.erase(storage.begin()->second);
+            storage.erase(storage.begin());
+        }
+
+        void push(key_type key, const T& value) {
+            index.emplace(key, storage.emplace(value, key).first);
+        }
+
+        [[nodiscard]] bool contains(key_type key) const {
+            return index.find(key) != index.end();
+        }
+
+        [[nodiscard]] const T& at(key_type key) const {
+            return index.at(key)->first;
+        }
+
+        template <typename Modifier>
+        void decrease(key_type key, Modifier modify) {
+            auto iterator = index.find(key);
+            if (iterator == index.end()) {
+                throw std::logic_error{ "open list does not contain updated key" };
+            }
+            auto node = storage.extract(iterator->second);
+            modify();
+            iterator->second = storage.insert(std::move(node)).position;
+        }
+
+        void clear() {
+            storage.clear();
+            index.clear();
+        }
+
+        [[nodiscard]] std::vector<T> values() const {
+            std::vector<T> result;
+            values(result);
+            return result;
+        }
+
+        /// replaces the content of `result`, reusing its memory
+        void values(std::vector<T>& result) const {
+            result.clear();
+            for (const auto& entry : storage) {
+                result.push_back(entry.first);
+            }
+        }
+    };
+
+    /// Indexed d-ary heap with in-place decrease-key
+    /// `slots` maps every key in [0, key_count) to the position of its value in `items`,
+    /// it is restored to `npos` on `pop`/`clear`, so the heap never rescans the whole key range
+    template <typename T, typename Compare, std::size_t Arity = 4>
+    class IndexedHeap {
+        static_assert(Arity >= 2, "heap arity must be at least 2");
+    public:
+        using key_type = std::size_t;
+        using compare_type = Compare;
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    private:
+        Compare compare;
+        std::vector<T> items;
+        std::vector<key_type> keys;
+        std::vector<std::size_t> slots;
+        OpenListBuffers<T>* buffers = nullptr;  // where arrays are returned to
+    public:
+        IndexedHeap(const Compare& compare, std::size_t key_count) : compare(compare), items{}, keys{}, slots(key_count, npos) {}
+
+        IndexedHeap(const Compare& compare, std::size_t key_count, OpenListBuffers<T>& reused) :
+            compare(compare),
+            items(std::move(reused.items)),
+            keys(std::move(reused.keys)),
+            slots(std::move(reused.slots)),
+            buffers(&reused)
+        {
+            items.clear();
+            keys.clear();
+            if (slots.size() != key_count) {
+                slots.assign(key_count, npos);
+            }
+        }
+
+        IndexedHeap(const IndexedHeap&) = delete;
+        IndexedHeap& operator = (const IndexedHeap&) = delete;
+
+        ~IndexedHeap() {
+            if (buffers != nullptr) {
+                clear();
+                buffers->items = std::move(items);
+                buffers->keys = std::move(keys);
+                buffers->slots = std::move(slots);
+            }
+        }
+
+        [[nodiscard]] bool empty() const {
+            return items.empty();
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return items.size();
+        }
+
+        [[nodiscard]] const T& top() const {
+            return items.front();
+        }
+
+        void pop() {
+            slots[keys.front()] = npos;
+            if (items.size() > 1) {
+                move(items.size() - 1, 0);
+            }
+            items.pop_back();
+            keys.pop_back();
+            if (!items.empty()) {
+                sift_down(0);
+            }
+        }
+
+        void push(key_type key, const T& value) {
+            slots[key] = items.size();
+            items.push_back(value);
+            keys.push_back(key);
+            sift_up(items.size() - 1);
+        }
+
+        [[nodiscard]] bool contains(key_type key) const {
+            return slots[key] != npos;
+        }
+
+        [[nodiscard]] const T& at(key_type key) const {
+            return items[slots[key]];
+        }
+
+        template <typename Modifier>
+        void decrease(key_type key, Modifier modify) {
+            std::size_t slot = slots[key];
+            if (slot == npos) {
+                throw std::logic_error{ "open list does not contain updated key" };
+            }
+            modify();
+            sift_up(slot);
+        }
+
+        /// removes the value stored under the key, if there is one
+        void erase(key_type key) {
+            std::size_t slot = slots[key];
+            if (slot == npos) {
+                return;
+            }
+            slots[key] = npos;
+            std::size_t last = items.size() - 1;
+            if (slot != last) {
+                move(last, slot);
+            }
+            items.pop_back();
+            keys.pop_back();
+            if (slot < items.size()) {
+                if (slot > 0 && compare(items[slot], items[(slot - 1) / Arity])) {
+                    sift_up(slot);
+                } else {
+                    sift_down(slot);
+                }
+            }
+        }
+
+        void clear() {
+            for (key_type key : keys) {
+                slots[key] = npos;
+            }
+            items.clear();
+            keys.clear();
+        }
+
+        [[nodiscard]] std::vector<T> values() const {
+            return items;
+        }
+
+        /// replaces the content of `result`, reusing its memory
+        void values(std::vector<T>& result) const {
+            result.assign(std::begin(items), std::end(items));
+        }
+
+    private:
+        void move(std::size_t from, std::size_t to) {
+            items[to] = std::move(items[from]);
+            keys[to] = keys[from];
+            slots[keys[to]] = to;
+        }
+
+        void sift_up(std::size_t slot) {
+            T value = std::move(items[slot]);
+            key_type key = keys[slot];
+            while (slot > 0) {
+                std::size_t parent = (slot - 1) / Arity;
+                if (!compare(value, items[parent])) {
+                    break;
+                }
+                move(parent, slot);
+                slot = parent;
+            }
+            items[slot] = std::move(value);
+            keys[slot] = key;
+            slots[key] = slot;
+        }
+
+        void sift_down(std::size_t slot) {
+            T value = std::move(items[slot]);
+            key_type key = keys[slot];
+            std::size_t count = items.size();
+            while (true) {
+                std::size_t first_child = slot * Arity + 1;
+                if (first_child >= count) {
+                    break;
+                }
+                std::size_t best_child = first_child;
+                std::size_t last_child = std::min(first_child + Arity, count);
+                for (std::size_t child = first_child + 1; child < last_child; ++child) {
+                    if (compare(items[child], items[best_child])) {
+                        best_child = child;
+                    }
+                }
+                if (!compare(items[best_child], value)) {
+                    break;
+                }
+                move(best_child, slot);
+                slot = best_child;
+            }
+            items[slot] = std::move(value);
+            keys[slot] = key;
+            slots[key] = slot;
+        }
+    };
+
+    template <typename T, typename Compare>
+    using BinaryHeap = IndexedHeap<T, Compare, 2>;
+
+    template <typename T, typename Compare>
+    using QuaternaryHeap = IndexedHeap<T, Compare, 4>;
+}
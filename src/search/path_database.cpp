@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "path_database.hpp"
+#include "context.hpp"
+#include "first_moves.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    constexpr std::array<char, 8> database_magic = { 'C', 'P', 'D', 'R', 'U', 'N', 'S', '1' };
+
+    // targets of other connected areas and the source itself accept any first move
+    constexpr std::uint8_t any_move = 0xFFu;
+
+    std::uint32_t pack_run(std::size_t first_target, std::size_t direction) {
+        return static_cast<std::uint32_t>(first_target << 3u | direction);
+    }
+}
+
+
+namespace planner {
+    PathDatabase::PathDatabase(const GridMap<>& map, const MoveRules& rules, std::size_t thread_count) :
+        cell_count(map.get_width() * map.get_height()),
+        numbers(cell_count, none),
+        components(cell_count, none),
+        offsets(cell_count + 1, 0),
+        runs{}
+    {
+        if (cell_count >= (std::size_t{ 1 } << 29u)) {
+            throw std::logic_error{ "map is too large for a path database" };
+        }
+        const std::size_t width = map.get_width();
+
+        // depth first order keeps cells of a corridor or a room together, so their first moves from far sources match
+        std::vector<std::size_t> cells, stack;
+        std::uint32_t component_count = 0;
+        for (std::size_t root = 0; root < cell_count; ++root) {
+            if (map(root % width, root / width) == CellType::obstacle || components[root] != none) {
+                continue;
+            }
+            stack.push_back(root);
+            components[root] = component_count;
+            while (!stack.empty()) {
+                std::size_t cell = stack.back();
+                stack.pop_back();
+                numbers[cell] = static_cast<std::uint32_t>(cells.size());
+                cells.push_back(cell);
+                std::size_t x = cell % width, y = cell / width;
+                for (std::uint32_t successors = rules(map.neighbourhood(x, y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t neighbour = (y + directions[direction].dy) * width + x + directions[direction].dx;
+                    if (components[neighbour] == none) {
+                        components[neighbour] = component_count;
+                        stack.push_back(neighbour);
+                    }
+                }
+            }
+            ++component_count;
+        }
+
+        std::vector<std::vector<std::uint32_t>> rows(cell_count);
+        if (thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::max<std::size_t>(1, std::min(thread_count, cells.size()));
+        std::atomic<std::size_t> next{ 0 };
+        auto worker = [&]() {
+            FirstMoveSearch search;
+            for (std::size_t number = next++; number < cells.size(); number = next++) {
+                const std::size_t source = cells[number];
+                search.run(map, rules, source);
+                // every run keeps the moves shared by all of its targets and takes the lowest one, when the next target has none of them
+                auto& row = rows[source];
+                std::size_t run_start = 0;
+                std::uint8_t run_moves = any_move;
+                for (std::size_t target_number = 0; target_number < cells.size(); ++target_number) {
+                    const std::size_t target = cells[target_number];
+                    std::uint8_t moves = target == source || components[target] != components[source] ? any_move : search.moves(target);
+                    if ((run_moves & moves) == 0) {
+                        row.push_back(pack_run(run_start, lowest_bit(run_moves)));
+                        run_start = target_number;
+                        run_moves = moves;
+                    } else {
+                        run_moves &= moves;
+                    }
+                }
+                row.push_back(pack_run(run_start, lowest_bit(run_moves)));
+                row.shrink_to_fit();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (std::size_t cell = 0; cell < cell_count; ++cell) {
+            offsets[cell + 1] = offsets[cell] + rows[cell].size();
+        }
+        runs.reserve(offsets.back());
+        for (auto& row : rows) {
+            runs.insert(std::end(runs), std::begin(row), std::end(row));
+            std::vector<std::uint32_t>{}.swap(row);
+        }
+    }
+
+    std::size_t PathDatabase::first_move(std::size_t from, std::size_t to) const {
+        if (from >= cell_count || to >= cell_count || from == to || components[from] == none || components[from] != components[to]) {
+            return no_move;
+        }
+        auto first = std::begin(runs) + static_cast<std::ptrdiff_t>(offsets[from]);
+        auto last = std::begin(runs) + static_cast<std::ptrdiff_t>(offsets[from + 1]);
+        // the run of the target is the last one, which starts at or before its number
+        auto run = std::upper_bound(first, last, pack_run(numbers[to], 7));
+        return *(run - 1) & 7u;
+    }
+
+    void PathDatabase::save(std::ostream& output, std::uint64_t key) const {
+        std::uint64_t counts[2] = { cell_count, runs.size() };
+        output.write(database_magic.data(), database_magic.size());
+        output.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        output.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        output.write(reinterpret_cast<const char*>(numbers.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t)));
+        output.write(reinterpret_cast<const char*>(components.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t)));
+        output.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>((cell_count + 1) * sizeof(std::uint64_t)));
+        output.write(reinterpret_cast<const char*>(runs.data()), static_cast<std::streamsize>(runs.size() * sizeof(std::uint32_t)));
+    }
+
+    std::optional<PathDatabase> PathDatabase::load(std::istream& input, std::uint64_t key, std::size_t cell_count) {
+        std::array<char, 8> magic{};
+        std::uint64_t stored_key = 0, counts[2] = { 0, 0 };
+        input.read(magic.data(), magic.size());
+        input.read(reinterpret_cast<char*>(&stored_key), sizeof(stored_key));
+        input.read(reinterpret_cast<char*>(counts), sizeof(counts));
+        if (!input || magic != database_magic || stored_key != key || counts[0] != cell_count) {
+            return std::nullopt;
+        }
+        // the run count is checked against the rest of the stream before anything is allocated
+        const std::uint64_t table_size = cell_count * (2 * sizeof(std::uint32_t) + sizeof(std::uint64_t)) + sizeof(std::uint64_t);
+        const auto position = input.tellg();
+        input.seekg(0, std::ios::end);
+        const auto stream_end = input.tellg();
+        input.seekg(position);
+        if (position < 0 || stream_end < position || !input) {
+            return std::nullopt;
+        }
+        const auto remaining = static_cast<std::uint64_t>(stream_end - position);
+        if (remaining < table_size || counts[1] > (remaining - table_size) / sizeof(std::uint32_t)) {
+            return std::nullopt;
+        }
+        PathDatabase database;
+        database.cell_count = cell_count;
+        database.numbers.resize(cell_count);
+        database.components.resize(cell_count);
+        database.offsets.resize(cell_count + 1);
+        database.runs.resize(counts[1]);
+        input.read(reinterpret_cast<char*>(database.numbers.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t)));
+        input.read(reinterpret_cast<char*>(database.components.data()), static_cast<std::streamsize>(cell_count * sizeof(std::uint32_t)));
+        input.read(reinterpret_cast<char*>(database.offsets.data()), static_cast<std::streamsize>((cell_count + 1) * sizeof(std::uint64_t)));
+        input.read(reinterpret_cast<char*>(database.runs.data()), static_cast<std::streamsize>(counts[1] * sizeof(std::uint32_t)));
+        if (!input || database.offsets.front() != 0 || database.offsets.back() != counts[1]) {
+            return std::nullopt;
+        }
+        // `first_move` relies on every free cell row being sorted and starting with the run of target number 0
+        for (std::size_t cell = 0; cell < cell_count; ++cell) {
+            const std::uint64_t first = database.offsets[cell], last = database.offsets[cell + 1];
+            const bool free = database.components[cell] != none;
+            if (free != (database.numbers[cell] != none) || last < first || last > counts[1]) {
+                return std::nullopt;
+            }
+            if (free && (database.numbers[cell] >= cell_count || database.components[cell] >= cell_count)) {
+                return std::nullopt;
+            }
+            if (free && (first == last || database.runs[first] >> 3u != 0)) {
+                return std::nullopt;
+            }
+            auto row_first = std::begin(database.runs) + static_cast<std::ptrdiff_t>(first);
+            auto row_last = std::begin(database.runs) + static_cast<std::ptrdiff_t>(last);
+            if (std::adjacent_find(row_first, row_last, std::greater_equal<>{}) != row_last) {
+                return std::nullopt;
+            }
+        }
+        return database;
+    }
+
+    PathDatabaseSearch::PathDatabaseSearch(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        cache_directory(std::move(cache_directory)),
+        databases{}
+    {}
+
+    std::shared_ptr<const PathDatabase> PathDatabaseSearch::database(const GridMap<CellType>& map) const {
+        return databases.get(map, [&]() {
+            if (cache_directory.empty()) {
+                return std::make_shared<const PathDatabase>(map, moves);
+            }
+            SidecarFile file{ cache_directory, map, options.allow_diagonal, options.cut_corners, options.allow_squeeze, ".cpd" };
+            if (std::ifstream input{ file.get_path(), std::ios::binary }; input) {
+                if (auto loaded = PathDatabase::load(input, file.get_key(), map.get_width() * map.get_height()); loaded) {
+                    return std::make_shared<const PathDatabase>(std::move(*loaded));
+                }
+            }
+            auto built = std::make_shared<const PathDatabase>(map, moves);
+            file.save([&](std::ostream& output) { built->save(output, file.get_key()); });
+            return built;
+        });
+    }
+
+    const SearchState& PathDatabaseSearch::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool /* store_history */) const {
+        check_heuristic(map);
+        auto first_moves = database(map);
+        auto start_time = std::chrono::high_resolution_clock::now();
+        SearchState& state = context.state;
+        state.reset();
+
+        const std::size_t width = map.get_width();
+        const std::size_t target = to.y * width + to.x;
+        bool free = map(from.x, from.y) != CellType::obstacle && map(to.x, to.y) != CellType::obstacle;
+        if (free && (from == to || first_moves->first_move(from.y * width + from.x, target) != PathDatabase::no_move)) {
+            Point current = from;
+            double travelled = 0;
+            state.path_indices.push_back(state.nodes.emplace(current, 0, (*heuristic)(current, to)));
+            while (!(current == to) && state.path_indices.size() <= first_moves->size()) {
+                std::size_t direction = first_moves->first_move(current.y * width + current.x, target);
+                if (direction == PathDatabase::no_move) {
+                    break;
+                }
+                travelled += MoveRules::cost(direction);
+                current = { current.x + directions[direction].dx, current.y + directions[direction].dy };
+                state.path_indices.push_back(state.nodes.emplace(current, travelled, (*heuristic)(current, to), state.path_indices.back()));
+            }
+            state.path_found = current == to;
+            if (!state.path_found) {
+                state.path_indices.clear();
+            }
+        }
+        state.statistics["databaseruns"] = static_cast<double>(first_moves->run_count());
+        state.time_spent = std::chrono::high_resolution_clock::now() - start_time;
+        return state;
+    }
+}
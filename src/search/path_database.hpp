@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Compressed path database (CPD): the first move of a shortest path from every free cell to every other free cell,
+    /// targets are numbered in depth first order, so that close cells get close numbers,
+    /// and a row of first moves of a source is stored as runs of targets with the same first move
+    class PathDatabase {
+    public:
+        static constexpr std::uint32_t none = 0xFFFFFFFFu;
+        static constexpr std::size_t no_move = 8;
+    private:
+        std::size_t cell_count = 0;
+        std::vector<std::uint32_t> numbers;  // of every cell in the target order, `none` for obstacles
+        std::vector<std::uint32_t> components;  // connected area of every cell, `none` for obstacles
+        std::vector<std::uint64_t> offsets;  // first run of every cell row, `cell_count + 1` values
+        std::vector<std::uint32_t> runs;  // `first target number << 3 | direction`
+    public:
+        PathDatabase() = default;
+
+        /// rows are built in parallel by `thread_count` threads, 0 means one per hardware thread
+        PathDatabase(const GridMap<>& map, const MoveRules& rules, std::size_t thread_count = 0);
+
+        /// direction of the first move of a shortest path between the cells,
+        /// `no_move` if the cells are equal, are not connected or are not free
+        [[nodiscard]] std::size_t first_move(std::size_t from, std::size_t to) const;
+
+        [[nodiscard]] std::size_t size() const {
+            return cell_count;
+        }
+
+        [[nodiscard]] std::size_t run_count() const {
+            return runs.size();
+        }
+
+        /// binary format in the native byte order, `key` identifies the map and move options the database was built for
+        void save(std::ostream& output, std::uint64_t key) const;
+
+        /// returns nothing, if the stream does not contain a valid database of `cell_count` cells saved with the same `key`,
+        /// the stream must be seekable, its length is checked before the tables are allocated
+        [[nodiscard]] static std::optional<PathDatabase> load(std::istream& input, std::uint64_t key, std::size_t cell_count);
+    };
+
+    /// Path extraction from a compressed path database by repeated first move lookups, without any search,
+    /// databases are built on the first search on a map and reused while the map is unchanged,
+    /// with non empty `cache_directory` they are also stored there and loaded by later runs on the same map
+    class PathDatabaseSearch : public Search {
+        MoveRules moves;
+        std::string cache_directory;
+        MapCache<PathDatabase> databases;
+    public:
+        PathDatabaseSearch(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options, std::string cache_directory = {});
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+
+        [[nodiscard]] std::shared_ptr<const PathDatabase> database(const GridMap<CellType>& map) const;
+    };
+}
@@ -1,7 +1,23 @@
 #pragma once
 #include "heuristic.hpp"
+#include "landmarks.hpp"
 #include "tiebreaker.hpp"
 #include "interface.hpp"
+#include "context.hpp"
 
 // algorithms
+#include "ara_star.hpp"
 #include "astar.hpp"
+#include "bidirectional.hpp"
+#include "breadth_first.hpp"
+#include "bucket_astar.hpp"
+#include "distance_field.hpp"
+#include "dstar_lite.hpp"
+#include "fringe_search.hpp"
+#include "goal_bounding.hpp"
+#include "hpa_star.hpp"
+#include "jump_point.hpp"
+#include "jump_point_plus.hpp"
+#include "path_database.hpp"
+#include "subgoal_graph.hpp"
+#include "theta_star.hpp"
@@ -0,0 +1,321 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "float_comparison.hpp"
+#include "context.hpp"
+#include "interface.hpp"
+#include "memory.hpp"
+#include "moves.hpp"
+#include "open_list.hpp"
+
+
+namespace planner {
+    using NodeIndex = Node::index_type;
+
+    /// `Breaker` is the type of the tie breaker, it is called directly, if the type is final
+    template <typename Breaker>
+    struct BasicNodeComparator {
+        static constexpr double rounding_bound = 1e-12;
+
+        double heuristic_weight;
+        const Breaker& tie_breaker;
+        const NodeArena& nodes;
+        const std::vector<ExactCost>* exact;  // exact values of nodes, if distances are exact, nodes are compared by them
+
+        BasicNodeComparator(double heuristic_weight, const TieBreaker& tie_breaker, const NodeArena& nodes, const std::vector<ExactCost>* exact = nullptr) :
+            heuristic_weight(heuristic_weight),
+            tie_breaker(static_cast<const Breaker&>(tie_breaker)),
+            nodes(nodes),
+            exact(exact)
+            {}
+
+        // <less> comparator: a < b
+        [[nodiscard]] bool operator () (NodeIndex a_index, NodeIndex b_index) const {
+            const Node& a = nodes[a_index];
+            const Node& b = nodes[b_index];
+            auto a_cumulative = a.distance + heuristic_weight * a.estimation;
+            auto b_cumulative = b.distance + heuristic_weight * b.estimation;
+            if (exact != nullptr) {
+                // node values are evaluated from exact ones with a few roundings, so they decide clearly different values
+                if (std::abs(a_cumulative - b_cumulative) > rounding_bound * (a_cumulative + b_cumulative)) {
+                    return a_cumulative < b_cumulative;
+                }
+                const ExactCost& a_cost = (*exact)[a_index];
+                const ExactCost& b_cost = (*exact)[b_index];
+                if (int order = exact_compare(a_cost.cumulative, b_cost.cumulative); order != 0) {
+                    return order < 0;
+                }
+                return tie_breaker(a, a_cost, b, b_cost);
+            }
+            if (very_close_equals(a_cumulative, b_cumulative)) {
+                return tie_breaker(a, b);
+            }
+            return a_cumulative < b_cumulative;
+        }
+    };
+
+    using NodeComparator = BasicNodeComparator<TieBreaker>;
+
+    /// Open list, node arena and per cell memory of a single best first search over a grid
+    template <typename OpenList>
+    struct SearchSpace {
+        NodeArena& nodes;
+        GridMemory& memory;
+        OpenList storage;
+        std::size_t width;
+        std::vector<ExactCost>* exact;  // exact values of nodes, the same as compared by the open list, if distances are exact
+        int weight;  // whole heuristic weight of exact searches
+
+        /// the open list keeps its arrays in `buffers` between searches
+        template <typename Comparator>
+        SearchSpace(NodeArena& nodes, GridMemory& memory, const Comparator& comparator, const GridMap<>& map, OpenListBuffers<NodeIndex>& buffers, std::vector<ExactCost>* exact = nullptr) :
+            nodes(nodes),
+            memory(memory),
+            storage{ comparator, map.get_width() * map.get_height(), buffers },
+            width(map.get_width()),
+            exact(exact),
+            weight(static_cast<int>(comparator.heuristic_weight))
+        {
+            memory.reset(map.get_width() * map.get_height());
+        }
+
+        std::size_t key(const Point& point) const {
+            return point.y * width + point.x;
+        }
+
+        void insert(NodeIndex index) {
+            std::size_t cell = key(nodes[index].position);
+            memory.open(cell, index, nodes[index].distance);
+            storage.push(cell, index);
+        }
+
+        bool empty() const {
+            return storage.empty();
+        }
+
+        std::size_t size() const {
+            return storage.size();
+        }
+
+        NodeIndex optimal() const {
+            return storage.top();
+        }
+
+        void erase_optimal() {
+            storage.pop();
+        }
+
+        void close(const Point& position) {
+            memory.close(key(position));
+        }
+
+        void relax(std::size_t cell, double distance, NodeIndex parent) {
+            NodeIndex index = memory[cell].node;
+            memory.relax(cell, distance);
+            storage.decrease(cell, [&]() {
+                nodes[index].distance = distance;
+                nodes[index].parent = parent;
+            });
+        }
+
+        /// opens `point` or improves its path, unless it is closed or already has a shorter path
+        template <typename Estimate>
+        void reach(const Point& point, double distance, NodeIndex parent, Estimate estimate) {
+            std::size_t cell = key(point);
+            if (memory.visited(cell)) {
+                if (!memory.closed(cell) && distance < memory[cell].distance) {
+                    relax(cell, distance, parent);
+                }
+            } else {
+                insert(nodes.emplace(point, distance, estimate(point), parent));
+            }
+        }
+
+        /// `reach` with exact distances, `estimate` returns exact estimations
+        template <typename Estimate>
+        void reach_exact(const Point& point, const number& distance, NodeIndex parent, Estimate estimate) {
+            std::size_t cell = key(point);
+            std::vector<ExactCost>& costs = *exact;
+            if (memory.visited(cell)) {
+                NodeIndex index = memory[cell].node;
+                if (!memory.closed(cell) && distance < costs[index].distance) {
+                    memory.relax(cell, evaluate(distance));
+                    storage.decrease(cell, [&]() {
+                        costs[index].distance = distance;
+                        costs[index].cumulative = cumulative(distance, costs[index].estimation);
+                        nodes[index].distance = evaluate(distance);
+                        nodes[index].parent = parent;
+                    });
+                }
+            } else {
+                length estimation = estimate(point);
+                costs.push_back(ExactCost{ distance, estimation, cumulative(distance, estimation) });
+                insert(nodes.emplace(point, evaluate(distance), evaluate(estimation), parent));
+            }
+        }
+
+        [[nodiscard]] length cumulative(const number& distance, const length& estimation) const {
+            // weight * sqrt(radicand) = sqrt(weight^2 * radicand)
+            return length{ distance + estimation.rational * number{ weight }, weight * weight * estimation.radicand };
+        }
+
+        std::vector<NodeIndex> open_nodes() const {
+            return storage.values();
+        }
+
+        void open_nodes(std::vector<NodeIndex>& result) const {
+            storage.values(result);
+        }
+    };
+
+    template <typename T>
+    struct OpenListTag {
+        using type = T;
+    };
+
+    /// calls `function` with `OpenListTag` of the open list implementation selected by `type`
+    template <typename Function>
+    decltype(auto) dispatch_open_list(OpenListType type, Function&& function) {
+        switch (type) {
+            case OpenListType::set:
+                return function(OpenListTag<SetOpenList<NodeIndex, NodeComparator>>{});
+            case OpenListType::binary_heap:
+                return function(OpenListTag<BinaryHeap<NodeIndex, NodeComparator>>{});
+            case OpenListType::quaternary_heap:
+                return function(OpenListTag<QuaternaryHeap<NodeIndex, NodeComparator>>{});
+        }
+        throw std::logic_error{ "unknown open list type" };
+    }
+
+    template <typename Metric, typename Breaker>
+    struct KernelTag {
+        using heuristic_type = Metric;
+        using tie_breaker_type = Breaker;
+    };
+
+    namespace detail {
+        template <typename Metric, typename Function>
+        bool dispatch_tie_breaker(const TieBreaker& tie_breaker, Function& function) {
+            if (dynamic_cast<const GMax*>(&tie_breaker) != nullptr) {
+                function(KernelTag<Metric, GMax>{});
+            } else if (dynamic_cast<const GMin*>(&tie_breaker) != nullptr) {
+                function(KernelTag<Metric, GMin>{});
+            } else {
+                return false;
+            }
+            return true;
+        }
+    }
+
+    /// calls `function` with `KernelTag` of the final types of the heuristic and the tie breaker, so a kernel instantiated
+    /// for them calls both directly, returns `false` without calling `function`, if either of them is not a standard one
+    template <typename Function>
+    bool dispatch_kernel(const Heuristic<Point>& heuristic, const TieBreaker& tie_breaker, Function&& function) {
+        if (dynamic_cast<const Diagonal<Point>*>(&heuristic) != nullptr) {
+            return detail::dispatch_tie_breaker<Diagonal<Point>>(tie_breaker, function);
+        } else if (dynamic_cast<const Manhattan<Point>*>(&heuristic) != nullptr) {
+            return detail::dispatch_tie_breaker<Manhattan<Point>>(tie_breaker, function);
+        } else if (dynamic_cast<const Euclidean<Point>*>(&heuristic) != nullptr) {
+            return detail::dispatch_tie_breaker<Euclidean<Point>>(tie_breaker, function);
+        } else if (dynamic_cast<const Chebyshev<Point>*>(&heuristic) != nullptr) {
+            return detail::dispatch_tie_breaker<Chebyshev<Point>>(tie_breaker, function);
+        }
+        return false;
+    }
+
+    /// Best first search loop shared by grid searches, `expand(optimal, search_space)` generates successors of a node,
+    /// `settle(optimal, search_space)` may still change the distance and parent of a node, which was just closed
+    /// with `exact` distances nodes are compared by exact values, `expand` must reach successors with `reach_exact`,
+    /// the heuristic must have exact values and its weight must be a whole number
+    /// the result is stored in `context.state`
+    template <typename OpenList, typename Expand, typename Settle>
+    SearchState& best_first_search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history, const Heuristic<Point>& heuristic, const TieBreaker& tie_breaker, const Options& options, Expand expand, Settle settle, bool exact = false) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SearchState& state = context.state;
+        state.reset();
+        GridMemory& memory = context.memory;
+        std::vector<ExactCost>* costs = exact ? &context.exact : nullptr;
+        typename OpenList::compare_type comparator{ options.heuristic_weight, tie_breaker, state.nodes, costs };
+        SearchSpace<OpenList> search_space{ state.nodes, memory, comparator, map, context.open, costs };
+        if (exact) {
+            context.exact.clear();
+            search_space.reach_exact(from, number{}, Node::none, [&heuristic, &to](const Point& point) { return *heuristic.exact(point, to); });
+        } else {
+            search_space.insert(state.nodes.emplace(from, 0, heuristic(from, to)));
+        }
+
+        auto snapshot = [&state](const std::vector<NodeIndex>& indices) {
+            std::vector<Node> result;
+            result.reserve(indices.size());
+            for (NodeIndex index : indices) {
+                result.push_back(state.nodes[index]);
+            }
+            return result;
+        };
+
+        NodeIndex goal = Node::none;
+        while (!search_space.empty()) {
+            NodeIndex optimal = search_space.optimal();
+            search_space.erase_optimal();
+            search_space.close(state.nodes[optimal].position);
+            settle(optimal, search_space);
+            if (state.nodes[optimal].position == to) {
+                state.path_found = true;
+                goal = optimal;
+                break;
+            }
+            expand(optimal, search_space);
+            state.closed_indices.push_back(optimal);
+            if (store_history) {
+                state.open_history.push_back(snapshot(search_space.open_nodes()));
+                state.closed_history.push_back(state.closed_indices.size());
+            }
+        }
+
+        if (state.path_found) {
+            for (NodeIndex current = goal; current != Node::none; current = state.nodes[current].parent) {
+                state.path_indices.push_back(current);
+            }
+            std::reverse(std::begin(state.path_indices), std::end(state.path_indices));
+
+            state.closed_indices.push_back(goal);
+            search_space.open_nodes(state.open_indices);
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        state.time_spent = end_time - start_time;
+
+        return state;
+    }
+
+    template <typename OpenList, typename Expand>
+    SearchState& best_first_search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history, const Heuristic<Point>& heuristic, const TieBreaker& tie_breaker, const Options& options, Expand expand, bool exact = false) {
+        return best_first_search<OpenList>(from, to, map, context, store_history, heuristic, tie_breaker, options, std::move(expand), [](NodeIndex, SearchSpace<OpenList>&) {}, exact);
+    }
+
+    /// inserts nodes for every cell skipped by the found path, consecutive path nodes must lie on a straight or diagonal line
+    template <typename Estimate>
+    void unfold_path(SearchState& state, Estimate estimate) {
+        std::vector<NodeIndex> cells{ state.path_indices.front() };
+        for (std::size_t i = 1; i < state.path_indices.size(); ++i) {
+            const Point target = state.nodes[state.path_indices[i]].position;
+            std::size_t direction = direction_between(state.nodes[cells.back()].position, target);
+            while (state.nodes[cells.back()].position.x + directions[direction].dx != target.x ||
+                   state.nodes[cells.back()].position.y + directions[direction].dy != target.y) {
+                const Node& previous = state.nodes[cells.back()];
+                Point next{ previous.position.x + directions[direction].dx, previous.position.y + directions[direction].dy };
+                double distance = previous.distance + MoveRules::cost(direction);
+                cells.push_back(state.nodes.emplace(next, distance, estimate(next), cells.back()));
+            }
+            cells.push_back(state.path_indices[i]);
+        }
+        state.path_indices = std::move(cells);
+    }
+}
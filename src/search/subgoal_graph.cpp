@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+#include "subgoal_graph.hpp"
+#include "search_space.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    bool allowed(const GridMap<>& map, const MoveRules& rules, const Point& point, std::size_t direction) {
+        return (rules(map.neighbourhood(point.x, point.y)) >> direction) & 1u;
+    }
+
+    Point step(const Point& point, std::size_t direction, std::size_t count = 1) {
+        return { point.x + count * directions[direction].dx, point.y + count * directions[direction].dy };
+    }
+
+    std::size_t direction_of(int dx, int dy) {
+        for (std::size_t direction = 0; direction < directions.size(); ++direction) {
+            if (directions[direction].dx == dx && directions[direction].dy == dy) {
+                return direction;
+            }
+        }
+        return 0;
+    }
+
+    /// pairs of moves, which make up all shortest paths inside one octant:
+    /// a diagonal move with one of its straight components, or two perpendicular straight moves without diagonal moves
+    std::vector<std::pair<std::size_t, std::size_t>> octants(bool allow_diagonal) {
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        for (std::size_t diagonal = 0; diagonal < directions.size(); diagonal += 2) {
+            if (allow_diagonal) {
+                result.emplace_back(diagonal, (diagonal + 7) % 8);
+                result.emplace_back(diagonal, diagonal + 1);
+            } else {
+                result.emplace_back(diagonal + 1, (diagonal + 3) % 8);
+            }
+        }
+        return result;
+    }
+
+    double heuristic_distance(const Point& from, const Point& to, bool allow_diagonal) {
+        std::size_t dx = from.x < to.x ? to.x - from.x : from.x - to.x;
+        std::size_t dy = from.y < to.y ? to.y - from.y : from.y - to.y;
+        if (!allow_diagonal) {
+            return static_cast<double>(dx + dy);
+        }
+        return static_cast<double>(std::min(dx, dy)) * MoveRules::cost(0) + static_cast<double>(std::max(dx, dy) - std::min(dx, dy));
+    }
+
+    /// finds a path as long as the heuristic distance by dynamic programming over the cells of all such paths,
+    /// writes its cells without `from` to `cells`, if it is given
+    bool heuristic_path(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal, const Point& from, const Point& to, std::vector<Point>* cells) {
+        const int sx = (from.x < to.x) - (to.x < from.x), sy = (from.y < to.y) - (to.y < from.y);
+        const std::size_t dx = from.x < to.x ? to.x - from.x : from.x - to.x;
+        const std::size_t dy = from.y < to.y ? to.y - from.y : from.y - to.y;
+        std::size_t first = direction_of(sx, 0), second = direction_of(0, sy);
+        std::size_t first_count = dx, second_count = dy;
+        if (allow_diagonal) {
+            first = direction_of(sx, sy);
+            first_count = std::min(dx, dy);
+            second = dx > dy ? direction_of(sx, 0) : direction_of(0, sy);
+            second_count = std::max(dx, dy) - first_count;
+        }
+        const std::size_t columns = second_count + 1;
+        auto position = [&](std::size_t i, std::size_t j) { return step(step(from, first, i), second, j); };
+        std::vector<std::uint8_t> reached((first_count + 1) * columns, 0);
+        reached[0] = 1;
+        for (std::size_t i = 0; i <= first_count; ++i) {
+            for (std::size_t j = 0; j <= second_count; ++j) {
+                if (i > 0 && reached[(i - 1) * columns + j] && allowed(map, rules, position(i - 1, j), first)) {
+                    reached[i * columns + j] = 1;
+                } else if (j > 0 && reached[i * columns + j - 1] && allowed(map, rules, position(i, j - 1), second)) {
+                    reached[i * columns + j] = 1;
+                }
+            }
+        }
+        if (!reached.back()) {
+            return false;
+        }
+        if (cells != nullptr) {
+            std::size_t begin = cells->size();
+            for (std::size_t i = first_count, j = second_count; i > 0 || j > 0;) {
+                cells->push_back(position(i, j));
+                if (i > 0 && reached[(i - 1) * columns + j] && allowed(map, rules, position(i - 1, j), first)) {
+                    --i;
+                } else {
+                    --j;
+                }
+            }
+            std::reverse(std::begin(*cells) + static_cast<std::ptrdiff_t>(begin), std::end(*cells));
+        }
+        return true;
+    }
+
+    /// a shortest path may have to pass the cell, if it enters the cell with one move and leaves it with another one,
+    /// and there is no other path between the cells before and after it, which is as long as the heuristic distance:
+    /// the same moves in the other order, when both moves belong to one octant, or any such path otherwise
+    bool is_subgoal(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal, const Point& point) {
+        for (std::size_t in = 0; in < directions.size(); ++in) {
+            // moves are symmetric, so the previous cell can move in, if the cell can move out in the opposite direction
+            if (!allowed(map, rules, point, (in + 4) % 8)) {
+                continue;
+            }
+            const Point previous = step(point, (in + 4) % 8);
+            for (std::size_t out = 0; out < directions.size(); ++out) {
+                if (out == in || out == (in + 4) % 8 || !allowed(map, rules, point, out)) {
+                    continue;
+                }
+                const Point next = step(point, out);
+                const double length = MoveRules::cost(in) + MoveRules::cost(out);
+                if (heuristic_distance(previous, next, allow_diagonal) < length - 1e-9) {
+                    if (!heuristic_path(map, rules, allow_diagonal, previous, next, nullptr)) {
+                        return true;
+                    }
+                } else if (!allowed(map, rules, previous, out) || !allowed(map, rules, step(previous, out), in)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// searches cells h-reachable from a source one octant at a time, without passing through subgoals,
+    /// calls `visit(cell)` for every reached subgoal, a subgoal may be visited once for each octant
+    /// `explored` marks cells reached in the current octant, its records are reused by later calls
+    template <typename Visit>
+    void explore(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal, const SubgoalGraph& graph, GridMemory& explored, const Point& source, Visit visit) {
+        const std::size_t width = map.get_width();
+        std::vector<Point> frontier;
+        for (auto [first, second] : octants(allow_diagonal)) {
+            explored.reset(width * map.get_height());
+            explored.open(source.y * width + source.x, Node::none, 0.0);
+            frontier.assign(1, source);
+            while (!frontier.empty()) {
+                Point point = frontier.back();
+                frontier.pop_back();
+                for (std::size_t direction : { first, second }) {
+                    if (!allowed(map, rules, point, direction)) {
+                        continue;
+                    }
+                    Point next = step(point, direction);
+                    std::size_t cell = next.y * width + next.x;
+                    if (explored.visited(cell)) {
+                        continue;
+                    }
+                    explored.open(cell, Node::none, 0.0);
+                    if (graph.number(cell) != SubgoalGraph::none) {
+                        visit(cell);
+                    } else {
+                        frontier.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<SubgoalGraph::Edge> direct_edges(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal, const SubgoalGraph& graph, GridMemory& explored, const Point& source) {
+        const std::size_t width = map.get_width();
+        std::vector<SubgoalGraph::Edge> edges;
+        explore(map, rules, allow_diagonal, graph, explored, source, [&](std::size_t cell) {
+            edges.push_back({ graph.number(cell), heuristic_distance(source, { cell % width, cell / width }, allow_diagonal) });
+        });
+        auto by_target = [](const SubgoalGraph::Edge& a, const SubgoalGraph::Edge& b) { return a.target < b.target; };
+        std::sort(std::begin(edges), std::end(edges), by_target);
+        edges.erase(std::unique(std::begin(edges), std::end(edges), [](const auto& a, const auto& b) { return a.target == b.target; }), std::end(edges));
+        return edges;
+    }
+}
+
+
+namespace planner {
+    SubgoalGraph::SubgoalGraph(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal) :
+        width(map.get_width()),
+        allow_diagonal(allow_diagonal),
+        numbers(map.get_width() * map.get_height(), none),
+        subgoals{}
+    {
+        for (std::size_t y = 0; y < map.get_height(); ++y) {
+            for (std::size_t x = 0; x < width; ++x) {
+                if (map(x, y) != CellType::obstacle && is_subgoal(map, rules, allow_diagonal, { x, y })) {
+                    numbers[y * width + x] = static_cast<std::uint32_t>(subgoals.size());
+                    subgoals.push_back({ y * width + x, {} });
+                }
+            }
+        }
+        GridMemory explored;
+        for (auto& subgoal : subgoals) {
+            subgoal.edges = direct_edges(map, rules, allow_diagonal, *this, explored, { subgoal.cell % width, subgoal.cell / width });
+        }
+    }
+
+    std::size_t SubgoalGraph::edge_count() const {
+        std::size_t count = 0;
+        for (const auto& subgoal : subgoals) {
+            count += subgoal.edges.size();
+        }
+        return count;
+    }
+
+    std::vector<SubgoalGraph::Edge> SubgoalGraph::connect(const GridMap<>& map, const MoveRules& rules, const Point& point, GridMemory& explored) const {
+        return direct_edges(map, rules, allow_diagonal, *this, explored, point);
+    }
+
+    SubgoalGraphSearch::SubgoalGraphSearch(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        graphs{}
+    {}
+
+    std::shared_ptr<const SubgoalGraph> SubgoalGraphSearch::graph(const GridMap<CellType>& map) const {
+        return graphs.get(map, [&]() { return std::make_shared<const SubgoalGraph>(map, moves, options.allow_diagonal); });
+    }
+
+    const SearchState& SubgoalGraphSearch::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto subgoal_graph = graph(map);
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const SubgoalGraph& subgoals = *subgoal_graph;
+        const std::size_t width = map.get_width();
+        auto position = [&](std::uint32_t number) {
+            std::size_t cell = subgoals.subgoal(number).cell;
+            return Point{ cell % width, cell / width };
+        };
+
+        const auto start_edges = subgoals.connect(map, moves, from, context.explored);
+        const auto finish_edges = subgoals.connect(map, moves, to, context.explored);
+        const bool direct = heuristic_path(map, moves, options.allow_diagonal, from, to, nullptr);
+
+        return dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+            SearchState& state = best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Point point = search_space.nodes[optimal].position;
+                const double distance = search_space.nodes[optimal].distance;
+                if (point == from) {
+                    for (const auto& edge : start_edges) {
+                        search_space.reach(position(edge.target), distance + edge.cost, optimal, estimate);
+                    }
+                    if (direct) {
+                        search_space.reach(to, distance + heuristic_distance(from, to, options.allow_diagonal), optimal, estimate);
+                    }
+                }
+                const std::uint32_t number = subgoals.number(point.y * width + point.x);
+                if (number == SubgoalGraph::none) {
+                    return;
+                }
+                for (const auto& edge : subgoals.subgoal(number).edges) {
+                    search_space.reach(position(edge.target), distance + edge.cost, optimal, estimate);
+                }
+                auto finish_edge = std::lower_bound(std::begin(finish_edges), std::end(finish_edges), number, [](const SubgoalGraph::Edge& edge, std::uint32_t target) {
+                    return edge.target < target;
+                });
+                if (finish_edge != std::end(finish_edges) && finish_edge->target == number) {
+                    search_space.reach(to, distance + finish_edge->cost, optimal, estimate);
+                }
+            });
+
+            if (state.path_found) {
+                // every edge is h-reachable, so it is refined without a search
+                std::vector<NodeIndex> cells{ state.path_indices.front() };
+                std::vector<Point> segment;
+                for (std::size_t i = 1; i < state.path_indices.size(); ++i) {
+                    const Point source = state.nodes[cells.back()].position;
+                    const Point target = state.nodes[state.path_indices[i]].position;
+                    segment.clear();
+                    if (!heuristic_path(map, moves, options.allow_diagonal, source, target, &segment)) {
+                        throw std::logic_error{ "subgoal graph edge is not h-reachable" };
+                    }
+                    for (std::size_t j = 0; j + 1 < segment.size(); ++j) {
+                        double step_distance = state.nodes[cells.back()].distance + MoveRules::cost(direction_between(state.nodes[cells.back()].position, segment[j]));
+                        cells.push_back(state.nodes.emplace(segment[j], step_distance, estimate(segment[j]), cells.back()));
+                    }
+                    cells.push_back(state.path_indices[i]);
+                }
+                state.path_indices = std::move(cells);
+            }
+            state.statistics["subgoals"] = static_cast<double>(subgoals.subgoal_count());
+            state.time_spent = std::chrono::high_resolution_clock::now() - start_time;
+            return state;
+        });
+    }
+}
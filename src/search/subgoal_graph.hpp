@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "cache.hpp"
+#include "interface.hpp"
+#include "memory.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Simple subgoal graph: subgoals are free cells at obstacle corners, around which shortest paths turn,
+    /// two subgoals are connected, if there is a path between them as long as the heuristic distance (h-reachable),
+    /// which does not pass through other subgoals (direct-h-reachable)
+    /// a subgoal is a cell, where two moves of a path can't be replaced by a path of the heuristic length avoiding the cell,
+    /// so corners are defined by the move rules and follow `cut_corners` and `allow_squeeze`
+    class SubgoalGraph {
+    public:
+        static constexpr std::uint32_t none = 0xFFFFFFFFu;
+
+        struct Edge {
+            std::uint32_t target;  // subgoal number
+            double cost;
+        };
+
+        struct Subgoal {
+            std::size_t cell;
+            std::vector<Edge> edges;
+        };
+    private:
+        std::size_t width;
+        bool allow_diagonal;
+        std::vector<std::uint32_t> numbers;  // subgoal number of every cell, `none` for other cells
+        std::vector<Subgoal> subgoals;
+    public:
+        SubgoalGraph(const GridMap<>& map, const MoveRules& rules, bool allow_diagonal);
+
+        /// subgoal number of the cell or `none`
+        [[nodiscard]] std::uint32_t number(std::size_t cell) const {
+            return numbers[cell];
+        }
+
+        [[nodiscard]] const Subgoal& subgoal(std::size_t number) const {
+            return subgoals[number];
+        }
+
+        [[nodiscard]] std::size_t subgoal_count() const {
+            return subgoals.size();
+        }
+
+        [[nodiscard]] std::size_t edge_count() const;
+
+        /// subgoals direct-h-reachable from the cell, ordered by their numbers, `explored` is scratch memory reused between calls
+        [[nodiscard]] std::vector<Edge> connect(const GridMap<>& map, const MoveRules& rules, const Point& point, GridMemory& explored) const;
+    };
+
+    /// A* over a subgoal graph: the start and the finish are connected to the subgoals they directly h-reach,
+    /// and every edge of the found path is refined to cells by a path of the heuristic length
+    /// finds the shortest paths, the graph is built by the first search on a map and is not included in the search time
+    class SubgoalGraphSearch : public Search {
+        MoveRules moves;
+        MapCache<SubgoalGraph> graphs;
+    public:
+        SubgoalGraphSearch(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options);
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+
+        [[nodiscard]] std::shared_ptr<const SubgoalGraph> graph(const GridMap<CellType>& map) const;
+    };
+}
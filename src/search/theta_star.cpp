@@ -0,0 +1,108 @@
+#include <cmath>
+#include <limits>
+#include "theta_star.hpp"
+#include "search_space.hpp"
+
+
+namespace {
+    using namespace planner;
+
+    double euclidean(const Point& a, const Point& b) {
+        double dx = static_cast<double>(a.x) - static_cast<double>(b.x);
+        double dy = static_cast<double>(a.y) - static_cast<double>(b.y);
+        return std::sqrt(dx * dx + dy * dy);
+    }
+}
+
+
+namespace planner {
+    ThetaStar::ThetaStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options) :
+        Search(std::move(heuristic), std::move(tie_breaker), options),
+        moves(options.allow_diagonal, options.cut_corners, options.allow_squeeze),
+        line_of_sight(options.allow_diagonal, options.cut_corners, options.allow_squeeze)
+    {}
+
+    const SearchState& ThetaStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+        std::size_t checks = 0;
+        SearchState& state = dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Node& node = search_space.nodes[optimal];
+                const Point position = node.position;
+                const double distance = node.distance;
+                const NodeIndex parent = node.parent;
+                for (std::uint32_t successors = moves(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    if (search_space.memory.closed(search_space.key(point))) {
+                        continue;
+                    }
+                    if (parent != Node::none) {
+                        const Point origin = search_space.nodes[parent].position;
+                        ++checks;
+                        if (line_of_sight(map, origin, point)) {
+                            search_space.reach(point, search_space.nodes[parent].distance + euclidean(origin, point), parent, estimate);
+                            continue;
+                        }
+                    }
+                    search_space.reach(point, distance + MoveRules::cost(direction), optimal, estimate);
+                }
+            });
+        });
+        state.statistics["lineofsightchecks"] = static_cast<double>(checks);
+        return state;
+    }
+
+    const SearchState& LazyThetaStar::search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history) const {
+        check_heuristic(map);
+        auto estimate = [this, &to](const Point& point) { return (*heuristic)(point, to); };
+        std::size_t checks = 0;
+        SearchState& state = dispatch_open_list(options.open_list, [&](auto tag) -> SearchState& {
+            using OpenList = typename decltype(tag)::type;
+            auto expand = [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                const Node& node = search_space.nodes[optimal];
+                const Point position = node.position;
+                const NodeIndex parent = node.parent == Node::none ? optimal : node.parent;
+                const Point origin = search_space.nodes[parent].position;
+                const double origin_distance = search_space.nodes[parent].distance;
+                for (std::uint32_t successors = moves(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    Point point{ position.x + directions[direction].dx, position.y + directions[direction].dy };
+                    search_space.reach(point, origin_distance + euclidean(origin, point), parent, estimate);
+                }
+            };
+            auto settle = [&](NodeIndex optimal, SearchSpace<OpenList>& search_space) {
+                Node& node = search_space.nodes[optimal];
+                if (node.parent == Node::none) {
+                    return;
+                }
+                const Point position = node.position;
+                const Point origin = search_space.nodes[node.parent].position;
+                ++checks;
+                if (line_of_sight(map, origin, position)) {
+                    return;
+                }
+                // moves are symmetric, so closed neighbours are found by the moves from the node itself
+                node.distance = std::numeric_limits<double>::infinity();
+                for (std::uint32_t successors = moves(map.neighbourhood(position.x, position.y)); successors != 0; successors &= successors - 1) {
+                    std::size_t direction = lowest_bit(successors);
+                    std::size_t cell = search_space.key({ position.x + directions[direction].dx, position.y + directions[direction].dy });
+                    if (search_space.memory.closed(cell)) {
+                        NodeIndex neighbour = search_space.memory[cell].node;
+                        double distance = search_space.nodes[neighbour].distance + MoveRules::cost(direction);
+                        if (distance < node.distance) {
+                            node.distance = distance;
+                            node.parent = neighbour;
+                        }
+                    }
+                }
+                search_space.memory.relax(search_space.key(position), node.distance);
+            };
+            return best_first_search<OpenList>(from, to, map, context, store_history, *heuristic, *tie_breaker, options, expand, settle);
+        });
+        state.statistics["lineofsightchecks"] = static_cast<double>(checks);
+        return state;
+    }
+}
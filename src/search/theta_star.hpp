@@ -0,0 +1,33 @@
+#pragma once
+#include <memory>
+#include "interface.hpp"
+#include "line_of_sight.hpp"
+#include "moves.hpp"
+
+
+namespace planner {
+    /// Any angle A*: a successor is connected to the parent of the expanded node, when it is visible from there,
+    /// path contains only turning points
+    class ThetaStar : public Search {
+    protected:
+        MoveRules moves;
+        LineOfSight line_of_sight;
+    public:
+        ThetaStar(std::shared_ptr<Heuristic<Point>> heuristic, std::shared_ptr<TieBreaker> tie_breaker, const Options& options);
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+
+    /// Theta* connecting successors to the parent of the expanded node without checks,
+    /// visibility is checked once a node is expanded, and its parent is replaced by the best closed neighbour if needed
+    class LazyThetaStar : public ThetaStar {
+    public:
+        using ThetaStar::ThetaStar;
+
+        using Search::search;
+
+        const SearchState& search(Point from, Point to, const GridMap<CellType>& map, SearchContext& context, bool store_history = false) const override;
+    };
+}
@@ -1,27 +1,23 @@
-#include "float_comparison.hpp"
-#include "interface.hpp"
+#include <cmath>
 #include "tiebreaker.hpp"
 
 
 namespace planner {
-    bool finalize(Point a, Point b) {
-        if (a.x == b.x) {
-            return a.y < b.y;
+    bool GMax::operator ()(const Node& a, const ExactCost& a_cost, const Node& b, const ExactCost& b_cost) const {
+        // node distances are evaluated from exact ones, so they decide clearly different distances
+        if (std::abs(a.distance - b.distance) > 1e-12 * (a.distance + b.distance)) {
+            return a.distance > b.distance;
         }
-        return a.x < b.x;
-    }
-
-    bool GMax::operator ()(const Node& a, const Node& b) const {
-        if (very_close_equals(a.distance, b.distance)) {
+        if (a_cost.distance == b_cost.distance) {
             return finalize(a.position, b.position);
         }
-        return a.distance > b.distance;
+        return a_cost.distance > b_cost.distance;
     }
 
-    bool GMin::operator ()(const Node& a, const Node& b) const {
-        if (very_close_equals(a.estimation, b.estimation)) {
-            return finalize(a.position, b.position);
+    bool GMin::operator ()(const Node& a, const ExactCost& a_cost, const Node& b, const ExactCost& b_cost) const {
+        if (int order = exact_compare(a_cost.estimation, b_cost.estimation); order != 0) {
+            return order > 0;
         }
-        return a.estimation > b.estimation;
+        return finalize(a.position, b.position);
     }
 }
@@ -1,22 +1,53 @@
 #pragma once
+#include "float_comparison.hpp"
+#include "node.hpp"
 
 
 namespace planner {
-    struct Node;
-
     /// TieBreaker interface
     /// invocation contract: only if node values are the same
     /// operator (): returns `true` if `a` is better than `b`
     struct TieBreaker {
         [[nodiscard]] virtual bool operator ()(const Node& a, const Node& b) const = 0;
+
+        /// the same with exact values of the nodes, only if their exact cumulative values are equal
+        /// by default exact values are ignored
+        [[nodiscard]] virtual bool operator ()(const Node& a, const ExactCost& /* a_cost */, const Node& b, const ExactCost& /* b_cost */) const {
+            return (*this)(a, b);
+        }
+
         virtual ~TieBreaker() = default;
     };
 
-    struct GMax : TieBreaker {
-        [[nodiscard]] bool operator ()(const Node &a, const Node &b) const override;
+    /// last resort order of nodes with equal values
+    inline bool finalize(Point a, Point b) {
+        if (a.x == b.x) {
+            return a.y < b.y;
+        }
+        return a.x < b.x;
+    }
+
+    // standard tie breakers are final and defined inline, so calls through their own type are direct and may be inlined
+
+    struct GMax final : TieBreaker {
+        [[nodiscard]] bool operator ()(const Node &a, const Node &b) const override {
+            if (very_close_equals(a.distance, b.distance)) {
+                return finalize(a.position, b.position);
+            }
+            return a.distance > b.distance;
+        }
+
+        [[nodiscard]] bool operator ()(const Node& a, const ExactCost& a_cost, const Node& b, const ExactCost& b_cost) const override;
     };
 
-    struct GMin : TieBreaker {
-        [[nodiscard]] bool operator ()(const Node &a, const Node &b) const override;
+    struct GMin final : TieBreaker {
+        [[nodiscard]] bool operator ()(const Node &a, const Node &b) const override {
+            if (very_close_equals(a.estimation, b.estimation)) {
+                return finalize(a.position, b.position);
+            }
+            return a.estimation > b.estimation;
+        }
+
+        [[nodiscard]] bool operator ()(const Node& a, const ExactCost& a_cost, const Node& b, const ExactCost& b_cost) const override;
     };
 }
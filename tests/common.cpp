@@ -1,3 +1,104 @@
+#include <boost/test/unit_test.hpp>
 #include "common.hpp"
 
+using namespace planner;
+
 IOAdapterFixture::IOAdapterFixture(const std::string &filename) : adapter(filename) {}
+
+GridMap<> random_map(std::mt19937& generator, std::size_t width, std::size_t height, double density) {
+    std::bernoulli_distribution obstacle{ density };
+    std::vector<int> cells(width * height);
+    for (auto& cell : cells) {
+        cell = obstacle(generator);
+    }
+    return GridMap<>{ width, height, 1.0, cells, InverseMapper{} };
+}
+
+std::vector<std::pair<Point, Point>> random_queries(std::mt19937& generator, const GridMap<>& map, std::size_t count) {
+    std::uniform_int_distribution<std::size_t> x_distribution{ 0, map.get_width() - 1 }, y_distribution{ 0, map.get_height() - 1 };
+    std::vector<std::pair<Point, Point>> queries;
+    for (std::size_t query = 0; query < count; ++query) {
+        Point from{ x_distribution(generator), y_distribution(generator) };
+        Point to{ x_distribution(generator), y_distribution(generator) };
+        if (map(from.x, from.y) != CellType::obstacle && map(to.x, to.y) != CellType::obstacle) {
+            queries.emplace_back(from, to);
+        }
+    }
+    return queries;
+}
+
+std::vector<Options> move_options() {
+    return {
+        { 1.0, false, false, false },
+        { 1.0, true, false, false },
+        { 1.0, true, true, false },
+        { 1.0, true, true, true },
+    };
+}
+
+std::shared_ptr<Heuristic<Point>> grid_heuristic(const Options& options) {
+    if (options.allow_diagonal) {
+        return std::make_shared<Diagonal<Point>>();
+    }
+    return std::make_shared<Manhattan<Point>>();
+}
+
+SearchState reference_search(Point from, Point to, const GridMap<>& map, const Options& options) {
+    AStar astar{ grid_heuristic(options), std::make_shared<GMax>(), options };
+    return astar.search(from, to, map);
+}
+
+bool check_path_length(const SearchState& result, const SearchState& expected) {
+    BOOST_REQUIRE_EQUAL(result.path_found, expected.path_found);
+    if (result.path_found) {
+        // both are zero, when the ends are the same
+        BOOST_CHECK_CLOSE(result.path_length() + 1.0, expected.path_length() + 1.0, 1e-9);
+    }
+    return result.path_found;
+}
+
+void check_path_moves(const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+    auto path = result.path();
+    BOOST_REQUIRE_GT(path.size(), 0u);
+    BOOST_CHECK_EQUAL(path.front().position, from);
+    BOOST_CHECK_EQUAL(path.back().position, to);
+    MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        const Point& previous = path[i - 1].position;
+        BOOST_CHECK(rules(map.neighbourhood(previous.x, previous.y)) & (1u << direction_between(previous, path[i].position)));
+    }
+    BOOST_CHECK_CLOSE(path.back().distance + 1.0, result.path_length() + 1.0, 1e-9);
+}
+
+void check_shortest_path(const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+    if (check_path_length(result, reference_search(from, to, map, options))) {
+        check_path_moves(result, from, to, map, options);
+    }
+}
+
+void for_random_maps(unsigned seed, const RandomMaps& maps, const std::vector<Options>& options_list,
+                     const std::function<void(std::mt19937& generator, const GridMap<>& map, const Options& options)>& visit) {
+    std::mt19937 generator{ seed };
+    for (std::size_t map_number = 0; map_number < maps.count; ++map_number) {
+        auto map = random_map(generator, maps.width, maps.height, maps.density);
+        for (const auto& options : options_list) {
+            BOOST_TEST_CONTEXT("map " << map_number << ", " << options) {
+                visit(generator, map, options);
+            }
+        }
+    }
+}
+
+void check_random_maps(unsigned seed, const RandomMaps& maps, const std::vector<Options>& options_list,
+                       const std::function<std::shared_ptr<Search>(const Options& options)>& make_search, const PathCheck& check) {
+    SearchContext context;
+    for_random_maps(seed, maps, options_list, [&](std::mt19937& generator, const GridMap<>& map, const Options& options) {
+        auto search = make_search(options);
+        for (const auto& [from, to] : random_queries(generator, map, maps.query_count)) {
+            const auto& result = search->search(from, to, map, context);
+            BOOST_TEST_CONTEXT(from << " -> " << to) {
+                check(result, from, to, map, options);
+            }
+        }
+    });
+}
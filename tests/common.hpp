@@ -1,6 +1,13 @@
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 #include "../src/ioadapter.hpp"
+#include "../src/search/search.hpp"
 
 
 struct IOAdapterFixture {
@@ -8,3 +15,50 @@ struct IOAdapterFixture {
 
     IOAdapterFixture(const std::string& filename = "data/test.xml");  // todo: add cmake variable for absolute path in `filename`
 };
+
+/// every cell is an obstacle with probability `density`
+planner::GridMap<> random_map(std::mt19937& generator, std::size_t width, std::size_t height, double density);
+
+/// `count` pairs of cells drawn at random, pairs with an obstacle at either end are dropped, so fewer pairs may be returned
+std::vector<std::pair<planner::Point, planner::Point>> random_queries(std::mt19937& generator, const planner::GridMap<>& map, std::size_t count);
+
+/// unit weight options with every combination of diagonal moves, corner cutting and squeezing
+std::vector<planner::Options> move_options();
+
+/// diagonal distance with diagonal moves and manhattan distance otherwise, both are exact on an empty map
+std::shared_ptr<planner::Heuristic<planner::Point>> grid_heuristic(const planner::Options& options);
+
+/// A* with `grid_heuristic`, the reference of engines, which find shortest paths
+planner::SearchState reference_search(planner::Point from, planner::Point to, const planner::GridMap<>& map, const planner::Options& options);
+
+/// checks, that the path is found iff the reference one is and has the same length, returns whether the path is found
+bool check_path_length(const planner::SearchState& result, const planner::SearchState& expected);
+
+/// checks, that the path goes from `from` to `to` by moves allowed by the options, and that its last node has the distance of its length
+void check_path_moves(const planner::SearchState& result, planner::Point from, planner::Point to, const planner::GridMap<>& map, const planner::Options& options);
+
+/// checks, that the path is as long as the `reference_search` one and goes by allowed moves
+void check_shortest_path(const planner::SearchState& result, planner::Point from, planner::Point to, const planner::GridMap<>& map, const planner::Options& options);
+
+/// sizes of random maps of a test and the number of queries drawn on each of them
+struct RandomMaps {
+    std::size_t count;
+    std::size_t width;
+    std::size_t height;
+    double density;
+    std::size_t query_count;
+};
+
+/// draws `maps.count` random maps and visits each of them with every options in a test context naming the map and options,
+/// visits get the generator to draw cells from
+void for_random_maps(unsigned seed, const RandomMaps& maps, const std::vector<planner::Options>& options_list,
+                     const std::function<void(std::mt19937& generator, const planner::GridMap<>& map, const planner::Options& options)>& visit);
+
+/// checks of the result of one query
+using PathCheck = std::function<void(const planner::SearchState& result, planner::Point from, planner::Point to, const planner::GridMap<>& map, const planner::Options& options)>;
+
+/// runs engines made by `make_search` on `maps.query_count` random queries of every map with one search context,
+/// an engine is made once per map and options, so it keeps its caches between the queries
+void check_random_maps(unsigned seed, const RandomMaps& maps, const std::vector<planner::Options>& options_list,
+                       const std::function<std::shared_ptr<planner::Search>(const planner::Options& options)>& make_search,
+                       const PathCheck& check = check_shortest_path);
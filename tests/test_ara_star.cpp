@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(ara_star)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    std::vector<Options> options_list = {
+        { 3.0, false, false, false },
+        { 3.0, true, false, false },
+        { 2.0, true, true, true },
+        { 2.5, true, true, false, OpenListType::set },
+    };
+    check_random_maps(19, { 20, 40, 30, 0.3, 10 }, options_list, [](const Options& options) {
+        return std::make_shared<AraStar>(grid_heuristic(options), std::make_shared<GMax>(), options, 0.5);
+    }, [](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+        auto optimal_options = options;
+        optimal_options.heuristic_weight = 1.0;
+        if (check_path_length(result, reference_search(from, to, map, optimal_options))) {
+            BOOST_CHECK_EQUAL(result.statistics.at("suboptimalitybound"), 1.0);
+            check_path_moves(result, from, to, map, options);
+        }
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_deadline) {
+    std::mt19937 generator{ 25 };
+    const size_t width = 300, height = 300;
+    auto map = random_map(generator, width, height, 0.2);
+    Point from{ 0, 0 }, to{ width - 1, height - 1 };
+    map.set_cells({ { from, CellType::empty }, { to, CellType::empty } });
+    Options options{ 5.0, true, true, false };
+    AStar astar{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), { 1.0, true, true, false } };
+    auto expected = astar.search(from, to, map);
+    BOOST_REQUIRE(expected.path_found);
+
+    // the first path is found even when the deadline is already over
+    AraStar hurried{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options, 0.1, std::chrono::microseconds{ 1 } };
+    auto first = hurried.search(from, to, map);
+    BOOST_REQUIRE(first.path_found);
+    BOOST_CHECK_EQUAL(first.statistics.at("iterations"), 1);
+    double bound = first.statistics.at("suboptimalitybound");
+    BOOST_CHECK_GE(bound, 1.0);
+    BOOST_CHECK_LE(bound, 5.0);
+    BOOST_CHECK_LE(first.path_length(), bound * expected.path_length() * (1 + 1e-9));
+
+    AraStar patient{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options, 0.1, std::chrono::seconds{ 60 } };
+    auto last = patient.search(from, to, map);
+    BOOST_REQUIRE(last.path_found);
+    BOOST_CHECK_CLOSE(last.path_length(), expected.path_length(), 1e-9);
+    BOOST_CHECK_LE(last.path_length(), first.path_length() * (1 + 1e-9));
+    BOOST_CHECK_GT(last.statistics.at("iterations"), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "common.hpp"
+#include "../src/batch.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(batch)
+
+BOOST_AUTO_TEST_CASE(test_read_scenario) {
+    GridMap<> map{ 49, 49, 1.0, std::vector<int>(49 * 49, 0), InverseMapper{} };
+    std::stringstream input{
+        "version 1\n"
+        "0\tarena.map\t49\t49\t1\t11\t1\t12\t1.00000000\n"
+        "\n"
+        "3\tarena.map\t49\t49\t17\t4\t5\t30\t30.55634918\n"
+    };
+    auto queries = read_scenario(input, map);
+    BOOST_REQUIRE_EQUAL(queries.size(), 2);
+    BOOST_CHECK_EQUAL(queries[0].from, (Point{ 1, 11 }));
+    BOOST_CHECK_EQUAL(queries[0].to, (Point{ 1, 12 }));
+    BOOST_CHECK_EQUAL(queries[1].from, (Point{ 17, 4 }));
+    BOOST_CHECK_EQUAL(queries[1].to, (Point{ 5, 30 }));
+
+    std::stringstream malformed{ "version 1\n0\tarena.map\t49\t49\t1\n" };
+    BOOST_CHECK_THROW(read_scenario(malformed, map), std::logic_error);
+
+    std::stringstream outside{ "version 1\n0\tarena.map\t49\t49\t1\t11\t1\t12\t1\n0\tarena.map\t49\t49\t1\t11\t49\t12\t48\n" };
+    try {
+        (void) read_scenario(outside, map);
+        BOOST_ERROR("a query outside of the map is read");
+    } catch (const std::logic_error& error) {
+        BOOST_CHECK_NE(std::string{ error.what() }.find("line 3"), std::string::npos);
+    }
+    map.set_cell(1, 12, CellType::obstacle);
+    std::stringstream blocked{ "0\tarena.map\t49\t49\t1\t11\t1\t12\t1\n" };
+    BOOST_CHECK_THROW(read_scenario(blocked, map), std::logic_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_read_queries, IOAdapterFixture) {
+    BOOST_CHECK(adapter.read_queries(adapter.read_map()).empty());
+
+    // the scenario file is found next to the input file
+    IOAdapter batch_adapter{ "data/batch.xml" };
+    auto map = batch_adapter.read_map();
+    auto queries = batch_adapter.read_queries(map);
+    std::vector<Query> expected = {
+        { { 0, 0 }, { 1, 1 } },
+        { { 2, 1 }, { 0, 0 } },
+        { { 1, 0 }, { 2, 1 } },
+        { { 0, 0 }, { 2, 1 } },
+    };
+    BOOST_REQUIRE_EQUAL(queries.size(), expected.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        BOOST_CHECK_EQUAL(queries[i].from, expected[i].from);
+        BOOST_CHECK_EQUAL(queries[i].to, expected[i].to);
+    }
+    // an end of the second scenario query becomes an obstacle
+    map.set_cell(2, 1, CellType::obstacle);
+    BOOST_CHECK_THROW((void) batch_adapter.read_queries(map), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_matches_single_queries) {
+    std::mt19937 generator{ 5 };
+    size_t width = 40, height = 30;
+    auto map = random_map(generator, width, height, 0.3);
+
+    std::uniform_int_distribution<size_t> x{ 0, width - 1 }, y{ 0, height - 1 };
+    std::vector<Query> queries;
+    while (queries.size() < 50) {
+        Query query{ { x(generator), y(generator) }, { x(generator), y(generator) } };
+        if (map(query.from.x, query.from.y) == CellType::empty && map(query.to.x, query.to.y) == CellType::empty) {
+            queries.push_back(query);
+        }
+    }
+
+    Options options{ 1.0, true, false, false };
+    std::vector<std::shared_ptr<Search>> searches = {
+        std::make_shared<AStar>(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options),
+        std::make_shared<JumpPoint>(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options),
+        std::make_shared<BreadthFirst>(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options),
+    };
+    for (const auto& search : searches) {
+        auto batch = run_batch(*search, map, queries);
+        BOOST_REQUIRE_EQUAL(batch.results.size(), queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto single = search->search(queries[i].from, queries[i].to, map);
+            BOOST_CHECK_EQUAL(batch.results[i].path_found, single.path_found);
+            BOOST_CHECK_CLOSE(batch.results[i].length, single.path_length(), 1e-9);
+            BOOST_CHECK_EQUAL(batch.results[i].steps, single.closed_indices.size());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_batch) {
+    std::mt19937 generator{ 6 };
+    size_t width = 64, height = 48;
+    auto map = random_map(generator, width, height, 0.25);
+
+    std::uniform_int_distribution<size_t> x{ 0, width - 1 }, y{ 0, height - 1 };
+    std::vector<Query> queries;
+    while (queries.size() < 300) {
+        Query query{ { x(generator), y(generator) }, { x(generator), y(generator) } };
+        if (map(query.from.x, query.from.y) == CellType::empty && map(query.to.x, query.to.y) == CellType::empty) {
+            queries.push_back(query);
+        }
+    }
+
+    Options options{ 1.0, true, true, false };
+    std::vector<std::shared_ptr<Search>> searches = {
+        std::make_shared<AStar>(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options),
+        std::make_shared<JumpPointPlus>(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options),
+    };
+    for (const auto& search : searches) {
+        auto sequential = run_batch(*search, map, queries);
+        BOOST_CHECK_EQUAL(sequential.thread_count, 1);
+        for (size_t thread_count : { 2, 4, 0 }) {
+            auto parallel = run_batch(*search, map, queries, thread_count);
+            BOOST_CHECK_GE(parallel.thread_count, 1);
+            BOOST_REQUIRE_EQUAL(parallel.results.size(), queries.size());
+            for (size_t i = 0; i < queries.size(); ++i) {
+                BOOST_CHECK_EQUAL(parallel.results[i].path_found, sequential.results[i].path_found);
+                BOOST_CHECK_EQUAL(parallel.results[i].length, sequential.results[i].length);
+                BOOST_CHECK_EQUAL(parallel.results[i].steps, sequential.results[i].steps);
+            }
+            BOOST_CHECK_GT(parallel.queries_per_second(), 0);
+        }
+    }
+
+    // more workers than queries
+    auto small = run_batch(*searches.front(), map, { queries.front() }, 8);
+    BOOST_CHECK_EQUAL(small.thread_count, 1);
+    BOOST_CHECK_EQUAL(small.results.size(), 1);
+    BOOST_CHECK(run_batch(*searches.front(), map, {}, 4).results.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(bidirectional)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    auto options_list = move_options();
+    options_list.push_back({ 0.0, true, true, false });
+    options_list.push_back({ 0.0, false, false, false, OpenListType::set });
+    check_random_maps(13, { 40, 31, 23, 0.3, 10 }, options_list, [](const Options& options) {
+        return std::make_shared<BidirectionalAStar>(grid_heuristic(options), std::make_shared<GMax>(), options);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_long_query) {
+    std::mt19937 generator{ 17 };
+    const size_t width = 120, height = 120;
+    auto map = random_map(generator, width, height, 0.2);
+    Point from{ 0, 0 }, to{ width - 1, height - 1 };
+    map.set_cells({ { from, CellType::empty }, { to, CellType::empty } });
+    // two balls of half the radius are smaller than one ball of the full radius
+    Options options{ 0.0, true, false, false };
+    AStar dijkstra{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    BidirectionalAStar bidirectional{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    auto expected = dijkstra.search(from, to, map);
+    auto result = bidirectional.search(from, to, map);
+    BOOST_REQUIRE(expected.path_found);
+    BOOST_REQUIRE(result.path_found);
+    BOOST_CHECK_CLOSE(result.path_length(), expected.path_length(), 1e-9);
+    BOOST_CHECK_GT(result.statistics.at("forwardsteps"), 0);
+    BOOST_CHECK_GT(result.statistics.at("backwardsteps"), 0);
+    BOOST_CHECK_LT(result.closed_indices.size(), expected.closed_indices.size());
+
+    auto same_cell = bidirectional.search(from, from, map);
+    BOOST_CHECK(same_cell.path_found);
+    BOOST_CHECK_EQUAL(same_cell.path().size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,57 @@
+#include <boost/test/unit_test.hpp>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+namespace {
+    size_t count_moves(const GridMap<>& map, const MoveRules& rules, Point from, Point to) {
+        std::vector<size_t> moves(map.get_width() * map.get_height(), std::numeric_limits<size_t>::max());
+        std::queue<Point> queue;
+        moves[from.y * map.get_width() + from.x] = 0;
+        queue.push(from);
+        while (!queue.empty()) {
+            Point current = queue.front();
+            queue.pop();
+            for (size_t direction = 0; direction < directions.size(); ++direction) {
+                if (rules(map.neighbourhood(current.x, current.y)) & (1u << direction)) {
+                    Point next{ current.x + directions[direction].dx, current.y + directions[direction].dy };
+                    if (moves[next.y * map.get_width() + next.x] == std::numeric_limits<size_t>::max()) {
+                        moves[next.y * map.get_width() + next.x] = moves[current.y * map.get_width() + current.x] + 1;
+                        queue.push(next);
+                    }
+                }
+            }
+        }
+        return moves[to.y * map.get_width() + to.x];
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(breadth_first)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    // rows span several words
+    check_random_maps(11, { 20, 150, 13, 0.3, 10 }, move_options(), [](const Options& options) {
+        return std::make_shared<BreadthFirst>(std::make_shared<Manhattan<Point>>(), std::make_shared<GMax>(), options);
+    }, [](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        size_t expected = count_moves(map, rules, from, to);
+        BOOST_REQUIRE_EQUAL(result.path_found, expected != std::numeric_limits<size_t>::max());
+        if (!result.path_found) {
+            return;
+        }
+        BOOST_CHECK_EQUAL(result.path().size(), expected + 1);
+        check_path_moves(result, from, to, map, options);
+        if (!options.allow_diagonal) {
+            check_path_length(result, reference_search(from, to, map, options));
+        }
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
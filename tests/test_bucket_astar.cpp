@@ -0,0 +1,47 @@
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(bucket_astar)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    auto options_list = move_options();
+    options_list.push_back({ 0.0, true, true, false });
+    for (std::size_t kind = 0; kind < 3; ++kind) {
+        check_random_maps(59, { 15, 40, 30, 0.3, 10 }, options_list, [kind](const Options& options) {
+            std::vector<std::shared_ptr<Heuristic<Point>>> heuristics = { std::make_shared<Euclidean<Point>>(), std::make_shared<Chebyshev<Point>>(), grid_heuristic(options) };
+            return std::make_shared<BucketAStar>(heuristics[kind], std::make_shared<GMin>(), options);
+        });
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_tie_breaking) {
+    // on an empty map every cell between the ends, from which the finish is reached by the same moves, has the same exact F,
+    // g-max goes straight to the finish, g-min expands all of them
+    GridMap<> map{ 20, 5, 1.0, std::vector<int>(100, 0), InverseMapper{} };
+    Options options{ 1.0, true, true, true };
+    BucketAStar g_max{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    BucketAStar g_min{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMin>(), options };
+    auto deep = g_max.search({ 0, 0 }, { 19, 4 }, map);
+    auto wide = g_min.search({ 0, 0 }, { 19, 4 }, map);
+    BOOST_REQUIRE(deep.path_found && wide.path_found);
+    BOOST_CHECK_CLOSE(deep.path_length(), 15 + 4 * std::sqrt(2.0), 1e-9);
+    BOOST_CHECK_CLOSE(wide.path_length(), 15 + 4 * std::sqrt(2.0), 1e-9);
+    BOOST_CHECK_EQUAL(deep.closed_indices.size(), 20u);
+    BOOST_CHECK_GT(wide.closed_indices.size(), 40u);
+}
+
+BOOST_AUTO_TEST_CASE(test_unsupported) {
+    Options weighted{ 2.0, true, true, true };
+    BOOST_CHECK_THROW(BucketAStar(std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), weighted), std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
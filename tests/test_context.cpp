@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+namespace {
+    std::atomic<std::size_t> allocation_count{ 0 };
+}
+
+// every allocation of the test binary is counted, the counter is only compared around searches
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /* size */) noexcept {
+    std::free(pointer);
+}
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(context)
+
+BOOST_AUTO_TEST_CASE(test_steady_state_allocations) {
+    std::mt19937 generator{ 59 };
+    const size_t width = 64, height = 48;
+    auto map = random_map(generator, width, height, 0.25);
+    std::vector<std::pair<Point, Point>> queries;
+    std::uniform_int_distribution<size_t> x_distribution{ 0, width - 1 }, y_distribution{ 0, height - 1 };
+    while (queries.size() < 20) {
+        Point from{ x_distribution(generator), y_distribution(generator) };
+        Point to{ x_distribution(generator), y_distribution(generator) };
+        if (map(from.x, from.y) != CellType::obstacle && map(to.x, to.y) != CellType::obstacle) {
+            queries.emplace_back(from, to);
+        }
+    }
+
+    Options exact{ 1.0, true, false, false };
+    exact.exact_distances = true;
+    std::vector<Options> options_list = {
+        { 1.0, true, false, false },
+        { 0.0, true, true, true },
+        { 1.0, false, false, false, OpenListType::binary_heap },
+        exact,
+    };
+    for (const auto& options : options_list) {
+        AStar astar{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+        SearchContext context;
+        // the first pass sizes the buffers for the map and the longest query
+        for (const auto& [from, to] : queries) {
+            (void) astar.search(from, to, map, context);
+        }
+        std::size_t before = allocation_count;
+        size_t found = 0;
+        for (const auto& [from, to] : queries) {
+            found += astar.search(from, to, map, context).path_found;
+        }
+        std::size_t allocations = allocation_count - before;  // read before the test context allocates its message
+        BOOST_TEST_CONTEXT(options) {
+            BOOST_CHECK_GT(found, 0u);
+            BOOST_CHECK_EQUAL(allocations, 0u);
+        }
+    }
+
+    BucketAStar bucket{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMin>(), { 1.0, true, true, false } };
+    SearchContext context;
+    for (const auto& [from, to] : queries) {
+        (void) bucket.search(from, to, map, context);
+    }
+    std::size_t before = allocation_count;
+    for (const auto& [from, to] : queries) {
+        (void) bucket.search(from, to, map, context);
+    }
+    BOOST_CHECK_EQUAL(allocation_count - before, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_breadth_first_buffers) {
+    GridMap<> map{ 100, 30, 1.0, std::vector<int>(100 * 30, 0), InverseMapper{} };
+    BreadthFirst search{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), { 1.0, true, true, false } };
+    SearchContext context;
+    BOOST_CHECK(search.search({ 0, 0 }, { 99, 29 }, map, context).path_found);
+    const auto* visited = context.breadth_first.visited.data();
+    std::size_t before = allocation_count;
+    const SearchState& state = search.search({ 99, 0 }, { 0, 29 }, map, context);
+    std::size_t allocations = allocation_count - before;
+    BOOST_CHECK(state.path_found);
+    BOOST_CHECK_EQUAL(state.path().size(), 100u);
+    BOOST_CHECK_EQUAL(context.breadth_first.visited.data(), visited);
+    // only the path cells and the statistics are allocated, not the bitsets and row ranges
+    BOOST_CHECK_LT(allocations, 8u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
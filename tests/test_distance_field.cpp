@@ -0,0 +1,122 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(distance_field)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    for_random_maps(59, { 4, 30, 25, 0.3, 0 }, move_options(), [](std::mt19937& generator, const GridMap<>& map, const Options& options) {
+        const size_t width = map.get_width(), height = map.get_height();
+        std::uniform_int_distribution<size_t> x_distribution{ 0, width - 1 }, y_distribution{ 0, height - 1 };
+        AStar astar{ grid_heuristic(options), std::make_shared<GMax>(), options };
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        Point goal{ x_distribution(generator), y_distribution(generator) };
+        while (map(goal.x, goal.y) == CellType::obstacle) {
+            goal = { x_distribution(generator), y_distribution(generator) };
+        }
+        DistanceField field{ map, rules, goal };
+        DistanceField tiled{ map, rules, goal, 4, 7 };
+        std::vector<Point> all_cells;
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                all_cells.push_back({ x, y });
+            }
+        }
+        auto expected = astar.search_many(goal, all_cells, map);
+        for (size_t cell = 0; cell < all_cells.size(); ++cell) {
+            const Point& from = all_cells[cell];
+            BOOST_TEST_CONTEXT(from << " -> " << goal) {
+                BOOST_CHECK_EQUAL(field.distance(from), tiled.distance(from));
+                if (!expected.found(cell)) {
+                    BOOST_CHECK_EQUAL(field.distance(from), std::numeric_limits<double>::infinity());
+                    BOOST_CHECK_EQUAL(field.move(from), DistanceField::no_move);
+                    continue;
+                }
+                BOOST_CHECK_CLOSE(field.distance(from) + 1.0, expected.distances[cell] + 1.0, 1e-9);
+                // following either flow field reaches the goal by a shortest path
+                for (const auto* flow : { &field, &tiled }) {
+                    Point current = from;
+                    double length = 0;
+                    for (size_t step = 0; step < all_cells.size() && !(current == goal); ++step) {
+                        std::size_t direction = flow->move(current);
+                        BOOST_REQUIRE_NE(direction, DistanceField::no_move);
+                        BOOST_REQUIRE(rules(map.neighbourhood(current.x, current.y)) & (1u << direction));
+                        length += MoveRules::cost(direction);
+                        current = flow->next(current);
+                    }
+                    BOOST_CHECK_EQUAL(current, goal);
+                    BOOST_CHECK_CLOSE(length + 1.0, field.distance(from) + 1.0, 1e-9);
+                }
+            }
+        }
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_goal_on_obstacle) {
+    GridMap<> map{ 3, 2, 1.0, std::vector<int>{ 0, 1, 0, 0, 0, 0 }, InverseMapper{} };
+    DistanceField field{ map, MoveRules{ true, true, true }, { 1, 0 } };
+    for (size_t y = 0; y < 2; ++y) {
+        for (size_t x = 0; x < 3; ++x) {
+            BOOST_CHECK_EQUAL(field.distance({ x, y }), std::numeric_limits<double>::infinity());
+            BOOST_CHECK_EQUAL(field.next({ x, y }), (Point{ x, y }));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_persistence) {
+    GridMap<> map{ 20, 15, 1.0, std::vector<int>(20 * 15, 0), InverseMapper{} };
+    for (size_t y = 0; y < 12; ++y) {
+        map.set_cell(10, y, CellType::obstacle);
+    }
+    DistanceField field{ map, MoveRules{ true, false, false }, { 3, 4 }, 0, 8 };
+    BOOST_CHECK_EQUAL(field.distance({ 3, 4 }), 0.0);
+    BOOST_CHECK_EQUAL(field.distance({ 10, 5 }), std::numeric_limits<double>::infinity());
+
+    std::stringstream stream;
+    field.save(stream);
+    std::string saved = stream.str();
+    std::stringstream input{ saved };
+    auto loaded = DistanceField::load(input);
+    BOOST_REQUIRE(loaded.has_value());
+    BOOST_CHECK_EQUAL(loaded->get_width(), 20u);
+    BOOST_CHECK_EQUAL(loaded->get_height(), 15u);
+    BOOST_CHECK_EQUAL(loaded->get_goal(), (Point{ 3, 4 }));
+    for (size_t y = 0; y < 15; ++y) {
+        for (size_t x = 0; x < 20; ++x) {
+            BOOST_CHECK_EQUAL(loaded->distance({ x, y }), field.distance({ x, y }));
+            BOOST_CHECK_EQUAL(loaded->move({ x, y }), field.move({ x, y }));
+        }
+    }
+    std::stringstream truncated{ saved.substr(0, saved.size() - 1) };
+    BOOST_CHECK(!DistanceField::load(truncated).has_value());
+    std::stringstream garbage{ "not a distance field" };
+    BOOST_CHECK(!DistanceField::load(garbage).has_value());
+
+    // moves follow the header and the distances
+    const size_t moves_offset = 8 + 4 * sizeof(std::uint64_t) + 20 * 15 * sizeof(double);
+    std::string bad_move = saved;
+    bad_move[moves_offset] = static_cast<char>(DistanceField::no_move + 1);
+    std::stringstream bad_move_input{ bad_move };
+    BOOST_CHECK(!DistanceField::load(bad_move_input).has_value());
+
+    // huge dimensions are rejected without allocating them
+    for (std::uint64_t height : { std::uint64_t{ 1 } << 40u, std::numeric_limits<std::uint64_t>::max() }) {
+        std::string huge = saved;
+        std::memcpy(huge.data() + 8 + sizeof(std::uint64_t), &height, sizeof(height));
+        std::stringstream huge_input{ huge };
+        BOOST_CHECK(!DistanceField::load(huge_input).has_value());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(dstar_lite)
+
+BOOST_AUTO_TEST_CASE(test_random_changes) {
+    std::mt19937 generator{ 29 };
+    std::bernoulli_distribution obstacle{ 0.25 };
+    const size_t width = 30, height = 20;
+    std::uniform_int_distribution<size_t> x_distribution{ 0, width - 1 }, y_distribution{ 0, height - 1 };
+    for (size_t map_number = 0; map_number < 10; ++map_number) {
+        for (const auto& options : move_options()) {
+            auto map = random_map(generator, width, height, 0.25);
+            Point from{ x_distribution(generator), y_distribution(generator) };
+            Point to{ x_distribution(generator), y_distribution(generator) };
+            map.set_cells({ { from, CellType::empty }, { to, CellType::empty } });
+
+            DStarLite planner{ map, grid_heuristic(options), options, from, to };
+            for (size_t step = 0; step < 15; ++step) {
+                const auto& result = planner.plan();
+                BOOST_TEST_CONTEXT("map " << map_number << ", step " << step << ", " << from << " -> " << to << ", " << options) {
+                    if (check_path_length(result, reference_search(from, to, map, options))) {
+                        check_path_moves(result, from, to, map, options);
+                        auto path = result.path();
+                        // walk a step along the path
+                        if (step % 3 == 0 && path.size() > 2) {
+                            from = path[1].position;
+                            planner.move_start(from);
+                        }
+                    }
+                }
+
+                std::vector<std::pair<Point, CellType>> changes;
+                for (size_t i = 0; i < 4; ++i) {
+                    Point point{ x_distribution(generator), y_distribution(generator) };
+                    if (!(point == from) && !(point == to)) {
+                        changes.emplace_back(point, obstacle(generator) ? CellType::obstacle : CellType::empty);
+                    }
+                }
+                planner.update_cells(map.set_cells(changes));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_replanning_is_local) {
+    const size_t width = 200, height = 200;
+    std::mt19937 generator{ 31 };
+    auto map = random_map(generator, width, height, 0.2);
+    Point from{ 0, 0 }, to{ width - 1, height - 1 };
+    map.set_cells({ { from, CellType::empty }, { to, CellType::empty } });
+    Options options{ 1.0, true, true, true };
+    DStarLite planner{ map, std::make_shared<Diagonal<Point>>(), options, from, to };
+    auto initial = planner.plan();
+    BOOST_REQUIRE(initial.path_found);
+
+    // block a cell in the middle of the path, near the start
+    auto path = initial.path();
+    Point blocked = path[5].position;
+    planner.update_cells(map.set_cells({ { blocked, CellType::obstacle } }));
+    const auto& repaired = planner.plan();
+    BOOST_REQUIRE(repaired.path_found);
+    AStar astar{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    BOOST_CHECK_CLOSE(repaired.path_length(), astar.search(from, to, map).path_length(), 1e-9);
+    BOOST_CHECK_LT(repaired.closed_indices.size() * 4, initial.closed_indices.size());
+
+    // no changes, nothing to repair
+    BOOST_CHECK(planner.plan().closed_indices.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,39 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(fringe_search)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    check_random_maps(53, { 15, 40, 30, 0.3, 20 }, move_options(), [](const Options& options) {
+        return std::make_shared<FringeSearch>(grid_heuristic(options), std::make_shared<GMax>(), options);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_iterations) {
+    // the threshold starts at the heuristic distance, which is exact on an empty map
+    GridMap<> map{ 10, 10, 1.0, std::vector<int>(100, 0), InverseMapper{} };
+    FringeSearch fringe{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), Options{ 1.0, true, true, true } };
+    auto result = fringe.search({ 0, 0 }, { 9, 5 }, map);
+    BOOST_REQUIRE(result.path_found);
+    BOOST_CHECK_EQUAL(result.statistics.at("iterations"), 1.0);
+    BOOST_CHECK_EQUAL(result.path().size(), 10u);
+
+    // a wall makes the scan raise the threshold
+    std::vector<int> cells(100, 0);
+    for (size_t y = 0; y < 9; ++y) {
+        cells[y * 10 + 5] = 1;
+    }
+    GridMap<> walled{ 10, 10, 1.0, cells, InverseMapper{} };
+    auto detour = fringe.search({ 0, 0 }, { 9, 0 }, walled);
+    BOOST_REQUIRE(detour.path_found);
+    BOOST_CHECK_GT(detour.statistics.at("iterations"), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
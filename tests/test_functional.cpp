@@ -3,6 +3,8 @@
 #include <boost/test/data/monomorphic.hpp>
 #include <filesystem>
 #include <iterator>
+#include <memory>
+#include <utility>
 #include "common.hpp"
 
 
@@ -31,6 +33,19 @@ namespace boost::unit_test::data::monomorphic {
 
 const std::filesystem::path FunctionalTestDataset::tests_directory{ "data/functional/" };
 
+namespace {
+    // wraps a tie breaker into a type unknown to the search, so it runs without specialized kernels
+    struct OpaqueTieBreaker : planner::TieBreaker {
+        std::shared_ptr<planner::TieBreaker> inner;
+
+        explicit OpaqueTieBreaker(std::shared_ptr<planner::TieBreaker> inner) : inner(std::move(inner)) {}
+
+        [[nodiscard]] bool operator ()(const planner::Node& a, const planner::Node& b) const override {
+            return (*inner)(a, b);
+        }
+    };
+}
+
 
 BOOST_AUTO_TEST_SUITE(functional)
 
@@ -41,10 +56,105 @@ BOOST_DATA_TEST_CASE(dataset, FunctionalTestDataset{}, directory_entry) {
     IOAdapterFixture fixture{ directory_entry.path().u8string() };
     auto map = fixture.adapter.read_map();
     auto locations = fixture.adapter.read_locations();
-    auto search = fixture.adapter.read_algorithm();
+    auto search = fixture.adapter.read_algorithm(map);
     auto result = search->search(locations.first, locations.second, map);
     double expected_length = fixture.adapter.read_path_length();
     BOOST_CHECK_CLOSE(result.path_length(), expected_length, 1e-5);
 }
 
+BOOST_DATA_TEST_CASE(dataset_open_lists, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    double expected_length = fixture.adapter.read_path_length();
+    for (auto type : { planner::OpenListType::set, planner::OpenListType::binary_heap, planner::OpenListType::quaternary_heap }) {
+        auto options = search->get_options();
+        options.open_list = type;
+        planner::AStar astar{ search->get_heuristic(), search->get_tie_breaker(), options };
+        auto result = astar.search(locations.first, locations.second, map);
+        BOOST_TEST_CONTEXT("open list: " << type) {
+            BOOST_CHECK_CLOSE(result.path_length(), expected_length, 1e-5);
+        }
+    }
+}
+
+BOOST_DATA_TEST_CASE(dataset_kernels, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    planner::AStar specialized{ search->get_heuristic(), search->get_tie_breaker(), search->get_options() };
+    planner::AStar generic{ search->get_heuristic(), std::make_shared<OpaqueTieBreaker>(search->get_tie_breaker()), search->get_options() };
+    auto expected = generic.search(locations.first, locations.second, map);
+    auto result = specialized.search(locations.first, locations.second, map);
+    BOOST_CHECK_EQUAL(result.path_length(), expected.path_length());
+    BOOST_CHECK_EQUAL(result.closed_indices.size(), expected.closed_indices.size());
+    BOOST_CHECK_EQUAL(result.open_indices.size(), expected.open_indices.size());
+}
+
+BOOST_DATA_TEST_CASE(dataset_exact_distances, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    auto options = search->get_options();
+    options.exact_distances = true;
+    planner::AStar astar{ search->get_heuristic(), search->get_tie_breaker(), options };
+    double expected_length = fixture.adapter.read_path_length();
+    BOOST_CHECK_CLOSE(astar.search(locations.first, locations.second, map).path_length(), expected_length, 1e-5);
+}
+
+BOOST_DATA_TEST_CASE(dataset_jump_point, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    planner::JumpPoint jump_point{ search->get_heuristic(), search->get_tie_breaker(), search->get_options() };
+    planner::JumpPointPlus jump_point_plus{ search->get_heuristic(), search->get_tie_breaker(), search->get_options() };
+    double expected_length = fixture.adapter.read_path_length();
+    BOOST_CHECK_CLOSE(jump_point.search(locations.first, locations.second, map).path_length(), expected_length, 1e-5);
+    BOOST_CHECK_CLOSE(jump_point_plus.search(locations.first, locations.second, map).path_length(), expected_length, 1e-5);
+}
+
+BOOST_DATA_TEST_CASE(dataset_bidirectional, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    planner::BidirectionalAStar bidirectional{ search->get_heuristic(), search->get_tie_breaker(), search->get_options() };
+    auto result = bidirectional.search(locations.first, locations.second, map);
+    double expected_length = fixture.adapter.read_path_length();
+    BOOST_CHECK_CLOSE(result.path_length(), expected_length, 1e-5);
+    BOOST_CHECK_EQUAL(result.statistics.at("forwardsteps") + result.statistics.at("backwardsteps"), result.closed_indices.size());
+}
+
+BOOST_DATA_TEST_CASE(dataset_fringe, FunctionalTestDataset{}, directory_entry) {
+    if (!directory_entry.is_regular_file()) {
+        return;
+    }
+    IOAdapterFixture fixture{ directory_entry.path().u8string() };
+    auto map = fixture.adapter.read_map();
+    auto locations = fixture.adapter.read_locations();
+    auto search = fixture.adapter.read_algorithm(map);
+    planner::FringeSearch fringe{ search->get_heuristic(), search->get_tie_breaker(), search->get_options() };
+    double expected_length = fixture.adapter.read_path_length();
+    BOOST_CHECK_CLOSE(fringe.search(locations.first, locations.second, map).path_length(), expected_length, 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+#include <boost/test/unit_test.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(goal_bounding)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    const RandomMaps maps{ 4, 30, 25, 0.3, 30 };
+    auto bounded = [](const Options& options) {
+        auto bounded_options = options;
+        bounded_options.goal_bounding = true;
+        return bounded_options;
+    };
+    // ties are broken differently with fewer open nodes, so only the total number of expansions is compared
+    size_t expansions = 0, expected_expansions = 0;
+    check_random_maps(47, maps, move_options(), [&](const Options& options) {
+        return std::make_shared<AStar>(grid_heuristic(options), std::make_shared<GMax>(), bounded(options));
+    }, [&](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+        auto expected = reference_search(from, to, map, options);
+        expected_expansions += expected.closed_indices.size();
+        expansions += result.closed_indices.size();
+        check_path_length(result, expected);
+    });
+    BOOST_CHECK_LT(expansions, expected_expansions);
+    check_random_maps(47, maps, move_options(), [&](const Options& options) {
+        return std::make_shared<JumpPoint>(grid_heuristic(options), std::make_shared<GMax>(), bounded(options));
+    }, [](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+        check_path_length(result, reference_search(from, to, map, options));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_boxes) {
+    // 0 0 0
+    // 1 1 0
+    // 0 0 0
+    GridMap<> map{ 3, 3, 1.0, std::vector<int>{ 0, 0, 0, 1, 1, 0, 0, 0, 0 }, InverseMapper{} };
+    GoalBounds bounds{ map, MoveRules{ false, false, false }, 2 };
+    BOOST_CHECK_EQUAL(bounds.size(), 9u);
+    // from (0, 0) every cell is reached by the move to the east only
+    BOOST_CHECK_EQUAL(bounds.moves_towards(0, { 0, 2 }), 1u << 5u);
+    BOOST_CHECK_EQUAL(bounds.moves_towards(0, { 2, 2 }), 1u << 5u);
+    const auto& east = bounds.box(0, 5);
+    BOOST_CHECK_EQUAL(east.min_x, 0u);
+    BOOST_CHECK_EQUAL(east.min_y, 0u);
+    BOOST_CHECK_EQUAL(east.max_x, 2u);
+    BOOST_CHECK_EQUAL(east.max_y, 2u);
+    // from (2, 1) the north and the south parts are split
+    BOOST_CHECK_EQUAL(bounds.moves_towards(5, { 0, 0 }), 1u << 7u);
+    BOOST_CHECK_EQUAL(bounds.moves_towards(5, { 0, 2 }), 1u << 3u);
+    BOOST_CHECK_EQUAL(bounds.moves_towards(5, { 2, 1 }), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_persistence) {
+    GridMap<> map{ 12, 10, 1.0, std::vector<int>(12 * 10, 0), InverseMapper{} };
+    map.set_cell(5, 3, CellType::obstacle);
+    map.set_cell(5, 4, CellType::obstacle);
+    GoalBounds bounds{ map, MoveRules{ true, true, false } };
+    auto same = [&bounds](const GoalBounds& other) {
+        for (size_t cell = 0; cell < 120; ++cell) {
+            for (size_t goal = 0; goal < 120; goal += 7) {
+                if (other.moves_towards(cell, { goal % 12, goal / 12 }) != bounds.moves_towards(cell, { goal % 12, goal / 12 })) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    std::stringstream stream;
+    bounds.save(stream, 5);
+    std::string saved = stream.str();
+    std::stringstream input{ saved };
+    auto loaded = GoalBounds::load(input, 5, 12, 10);
+    BOOST_REQUIRE(loaded.has_value());
+    BOOST_CHECK(same(*loaded));
+    std::stringstream other_key{ saved };
+    BOOST_CHECK(!GoalBounds::load(other_key, 6, 12, 10).has_value());
+    std::stringstream other_size{ saved };
+    BOOST_CHECK(!GoalBounds::load(other_size, 5, 10, 12).has_value());
+
+    auto filename = (std::filesystem::temp_directory_path() / "planner_test_goal_bounds.gb").string();
+    {
+        std::ofstream output{ filename, std::ios::binary };
+        bounds.save(output, 5);
+    }
+    auto mapped = GoalBounds::map_file(filename, 5, 12, 10);
+    BOOST_REQUIRE(mapped.has_value());
+    BOOST_CHECK(same(*mapped));
+    BOOST_CHECK(!GoalBounds::map_file(filename, 6, 12, 10).has_value());
+    std::filesystem::remove(filename);
+    BOOST_CHECK(!GoalBounds::map_file(filename, 5, 12, 10).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(test_cache_directory) {
+    auto directory = std::filesystem::temp_directory_path() / "planner_test_goal_bounds";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    GridMap<> map{ 16, 16, 1.0, std::vector<int>(16 * 16, 0), InverseMapper{} };
+    for (size_t y = 2; y < 14; ++y) {
+        map.set_cell(8, y, CellType::obstacle);
+    }
+    Options options{ 1.0, true, true, false };
+    options.goal_bounding = true;
+    AStar first{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options, directory.string() };
+    auto expected = first.search({ 2, 8 }, { 14, 8 }, map);
+    BOOST_CHECK_EQUAL(std::distance(std::filesystem::directory_iterator{ directory }, std::filesystem::directory_iterator{}), 1);
+    // the second search maps the saved bounds
+    AStar second{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options, directory.string() };
+    auto result = second.search({ 2, 8 }, { 14, 8 }, map);
+    BOOST_REQUIRE(result.path_found);
+    BOOST_CHECK_EQUAL(result.path_length(), expected.path_length());
+    BOOST_CHECK_EQUAL(result.closed_indices.size(), expected.closed_indices.size());
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(test_sidecar_files) {
+    GridMap<> map{ 8, 8, 1.0, std::vector<int>(8 * 8, 0), InverseMapper{} };
+    GridMap<> other{ 8, 8, 1.0, std::vector<int>(8 * 8, 0), InverseMapper{} };
+    other.set_cell(3, 3, CellType::obstacle);
+    std::set<std::uint64_t> keys;
+    for (const auto* grid : { &map, &other }) {
+        for (unsigned options = 0; options < 8; ++options) {
+            keys.insert(SidecarFile{ "", *grid, (options & 1u) != 0, (options & 2u) != 0, (options & 4u) != 0, ".gb" }.get_key());
+        }
+    }
+    BOOST_CHECK_EQUAL(keys.size(), 16u);
+
+    auto directory = std::filesystem::temp_directory_path() / "planner_test_sidecar";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    SidecarFile file{ directory.string(), map, true, true, false, ".gb" };
+    GoalBounds bounds{ map, MoveRules{ true, true, false } };
+    BOOST_REQUIRE(file.save([&](std::ostream& output) { bounds.save(output, file.get_key()); }));
+    auto mapped = GoalBounds::map_file(file.get_path(), file.get_key(), 8, 8);
+    BOOST_REQUIRE(mapped.has_value());
+    auto expected = mapped->moves_towards(0, { 7, 7 });
+    // replacing the file keeps the mapping of the previous one valid
+    BOOST_REQUIRE(file.save([&](std::ostream& output) { output << "replaced"; }));
+    BOOST_CHECK_EQUAL(mapped->moves_towards(0, { 7, 7 }), expected);
+    BOOST_CHECK(!GoalBounds::map_file(file.get_path(), file.get_key(), 8, 8).has_value());
+    BOOST_CHECK_EQUAL(std::distance(std::filesystem::directory_iterator{ directory }, std::filesystem::directory_iterator{}), 1);
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
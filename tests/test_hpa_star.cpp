@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(hpa_star)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    check_random_maps(37, { 15, 45, 35, 0.3, 10 }, move_options(), [](const Options& options) {
+        return std::make_shared<HPAStar>(grid_heuristic(options), std::make_shared<GMax>(), options, 8);
+    }, [](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+        auto expected = reference_search(from, to, map, options);
+        BOOST_REQUIRE_EQUAL(result.path_found, expected.path_found);
+        if (!result.path_found) {
+            return;
+        }
+        check_path_moves(result, from, to, map, options);
+        BOOST_CHECK_GE(result.path_length(), expected.path_length() * (1 - 1e-9));
+        BOOST_CHECK_LE(result.path_length(), expected.path_length() * 1.5);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_cluster_invalidation) {
+    std::mt19937 generator{ 41 };
+    auto map = random_map(generator, 64, 64, 0.2);
+    Options options{ 1.0, true, true, false };
+    HPAStar hpa_star{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options, 8 };
+
+    auto graph = hpa_star.graph(map);
+    BOOST_CHECK_EQUAL(graph->cluster_count(), 64);
+    BOOST_CHECK_EQUAL(graph->rebuilt_clusters(), 64);
+    BOOST_CHECK_EQUAL(hpa_star.graph(map), graph);
+
+    // a cell inside cluster (3, 3) affects transitions of the clusters around it only
+    map.set_cell(27, 28, map(27, 28) == CellType::obstacle ? CellType::empty : CellType::obstacle);
+    auto updated = hpa_star.graph(map);
+    BOOST_CHECK_NE(updated, graph);
+    BOOST_CHECK_EQUAL(updated->rebuilt_clusters(), 9);
+
+    ClusterGraph fresh{ map, MoveRules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze }, 8 };
+    for (size_t index = 0; index < fresh.cluster_count(); ++index) {
+        const auto& expected = fresh.cluster(index);
+        const auto& cluster = updated->cluster(index);
+        BOOST_CHECK(cluster.entrances == expected.entrances);
+        BOOST_CHECK(cluster.distances == expected.distances);
+        BOOST_CHECK_EQUAL(cluster.transitions.size(), expected.transitions.size());
+    }
+
+    AStar astar{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    Point from{ 1, 1 }, to{ 60, 62 };
+    map.set_cells({ { from, CellType::empty }, { to, CellType::empty } });
+    auto expected = astar.search(from, to, map);
+    auto result = hpa_star.search(from, to, map);
+    BOOST_CHECK_EQUAL(result.path_found, expected.path_found);
+    BOOST_CHECK_GT(result.statistics.at("abstractnodes"), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,8 @@
 #include <boost/test/unit_test.hpp>
+#include <fstream>
 #include <iterator>
+#include <sstream>
+#include <string>
 #include "common.hpp"
 #include "../src/ioadapter.hpp"
 #include "../src/search/interface.hpp"
@@ -31,7 +34,7 @@ BOOST_FIXTURE_TEST_CASE(test_read_locations, IOAdapterFixture) {
 }
 
 BOOST_FIXTURE_TEST_CASE(test_read_algorithm, IOAdapterFixture) {
-    auto algorithm = adapter.read_algorithm();
+    auto algorithm = adapter.read_algorithm(adapter.read_map());
     BOOST_CHECK_NO_THROW(dynamic_cast<AStar&>(*algorithm));
     BOOST_CHECK_NO_THROW(dynamic_cast<Diagonal<Point>&>(*algorithm->get_heuristic()));
     BOOST_CHECK_NO_THROW(dynamic_cast<GMax&>(*algorithm->get_tie_breaker()));
@@ -44,4 +47,19 @@ BOOST_FIXTURE_TEST_CASE(test_read_algorithm, IOAdapterFixture) {
     BOOST_CHECK_EQUAL(algorithm->get_options(), correct_options);
 }
 
+BOOST_AUTO_TEST_CASE(test_read_landmarks) {
+    std::ifstream file{ "data/test.xml" };
+    std::string document{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    document.insert(document.find("</algorithm>"), "<landmarks>2</landmarks>");
+    std::istringstream input{ document };
+    IOAdapter adapter{ input };
+    auto map = adapter.read_map();
+    auto algorithm = adapter.read_algorithm(map);
+    const auto& heuristic = dynamic_cast<const LandmarkHeuristic<Point>&>(*algorithm->get_heuristic());
+    BOOST_CHECK(heuristic.table->built_for(map));
+    BOOST_CHECK(!heuristic.table->built_for(adapter.read_map()));
+    map.set_cell(0, 0, CellType::obstacle);
+    BOOST_CHECK(!heuristic.table->built_for(map));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
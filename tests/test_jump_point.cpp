@@ -0,0 +1,58 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(jump_point)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    // paths of both engines are made of jumps, so only their lengths are compared
+    check_random_maps(42, { 40, 24, 17, 0.3, 10 }, move_options(), [](const Options& options) {
+        return std::make_shared<JumpPointPlus>(grid_heuristic(options), std::make_shared<GMax>(), options);
+    }, [](const SearchState& result_plus, Point from, Point to, const GridMap<>& map, const Options& options) {
+        JumpPoint jump_point{ grid_heuristic(options), std::make_shared<GMax>(), options };
+        auto expected = reference_search(from, to, map, options);
+        auto result = jump_point.search(from, to, map);
+        check_path_length(result, expected);
+        check_path_length(result_plus, expected);
+        BOOST_CHECK_EQUAL(result_plus.path().size(), result.path().size());
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_jump_table) {
+    // 0 0 0 0
+    // 0 1 0 0
+    // 0 0 0 0
+    GridMap<> map{ 4, 3, 1.0, std::vector<int>{ 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0 }, InverseMapper{} };
+    JumpTable table{ map, JumpRules{ true, false, false } };
+    const size_t right = 5, left = 1;
+    BOOST_CHECK_EQUAL(table(0, right), 2);  // (2, 0) has a forced neighbour (2, 1), which can't be reached cutting the corner
+    BOOST_CHECK_EQUAL(table(2, right), -1);  // blocked by the map border
+    BOOST_CHECK_EQUAL(table(4, right), 0);  // blocked by the obstacle
+    BOOST_CHECK_EQUAL(table(6, left), 0);
+
+    std::stringstream stream;
+    table.save(stream, 7);
+    std::string saved = stream.str();
+    std::stringstream input{ saved };
+    auto loaded = JumpTable::load(input, 7, 12);
+    BOOST_REQUIRE(loaded.has_value());
+    for (size_t cell = 0; cell < 12; ++cell) {
+        for (size_t direction = 0; direction < 8; ++direction) {
+            BOOST_CHECK_EQUAL((*loaded)(cell, direction), table(cell, direction));
+        }
+    }
+    std::stringstream other_key{ saved };
+    BOOST_CHECK(!JumpTable::load(other_key, 8, 12).has_value());
+    std::stringstream other_size{ saved };
+    BOOST_CHECK(!JumpTable::load(other_size, 7, 16).has_value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
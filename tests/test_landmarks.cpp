@@ -0,0 +1,110 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+namespace {
+    /// a cup open to the left, searches from inside of it towards the right side fill the cup first
+    GridMap<> cup(size_t width, size_t height) {
+        std::vector<int> cells(width * height, 0);
+        for (size_t y = 5; y + 5 <= height; ++y) {
+            cells[y * width + width / 2] = 1;
+        }
+        for (size_t x = width / 5; x <= width / 2; ++x) {
+            cells[5 * width + x] = 1;
+            cells[(height - 5) * width + x] = 1;
+        }
+        return GridMap<>{ width, height, 1.0, cells, InverseMapper{} };
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(landmarks)
+
+BOOST_AUTO_TEST_CASE(test_table) {
+    std::mt19937 generator{ 43 };
+    const size_t width = 40, height = 30;
+    auto map = random_map(generator, width, height, 0.3);
+    Options options{ 0.0, true, true, false };
+    MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+    LandmarkTable table{ map, rules, 6, 3 };
+    BOOST_REQUIRE_EQUAL(table.get_landmarks().size(), 6);
+
+    std::set<size_t> distinct;
+    AStar dijkstra{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), options };
+    std::uniform_int_distribution<size_t> x_distribution{ 0, width - 1 }, y_distribution{ 0, height - 1 };
+    for (size_t landmark = 0; landmark < 6; ++landmark) {
+        Point position = table.get_landmarks()[landmark];
+        distinct.insert(position.y * width + position.x);
+        BOOST_CHECK(map(position.x, position.y) == CellType::empty);
+        for (size_t query = 0; query < 20; ++query) {
+            Point to{ x_distribution(generator), y_distribution(generator) };
+            auto result = dijkstra.search(position, to, map);
+            if (result.path_found) {
+                BOOST_CHECK_CLOSE(table.distance(landmark, to), result.path_length(), 1e-4);
+            } else {
+                BOOST_CHECK_LT(table.distance(landmark, to), 0);
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(distinct.size(), 6);
+
+    // the bound never exceeds the distance
+    for (size_t query = 0; query < 200; ++query) {
+        Point from{ x_distribution(generator), y_distribution(generator) };
+        Point to{ x_distribution(generator), y_distribution(generator) };
+        auto result = dijkstra.search(from, to, map);
+        if (result.path_found) {
+            BOOST_CHECK_LE(table.lower_bound(from, to), result.path_length());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_trap) {
+    auto map = cup(60, 40);
+    Options options{ 1.0, true, false, false };
+    MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+    auto base = std::make_shared<Diagonal<Point>>();
+    auto landmark_heuristic = std::make_shared<LandmarkHeuristic<Point>>(std::make_shared<const LandmarkTable>(map, rules, 8), base);
+    AStar astar{ base, std::make_shared<GMax>(), options };
+    AStar alt{ landmark_heuristic, std::make_shared<GMax>(), options };
+    size_t plain_steps = 0, landmark_steps = 0;
+    for (Point from : { Point{ 20, 20 }, Point{ 5, 18 } }) {
+        for (Point to : { Point{ 50, 20 }, Point{ 45, 30 } }) {
+            auto expected = astar.search(from, to, map);
+            auto result = alt.search(from, to, map);
+            BOOST_TEST_CONTEXT(from << " -> " << to) {
+                BOOST_REQUIRE_EQUAL(result.path_found, expected.path_found);
+                BOOST_CHECK_CLOSE(result.path_length(), expected.path_length(), 1e-9);
+                BOOST_CHECK_GE((*landmark_heuristic)(from, to), (*base)(from, to));
+            }
+            plain_steps += expected.closed_indices.size();
+            landmark_steps += result.closed_indices.size();
+        }
+    }
+    BOOST_CHECK_LT(landmark_steps * 2, plain_steps);
+}
+
+BOOST_AUTO_TEST_CASE(test_stale_table) {
+    auto map = cup(60, 40);
+    Options options{ 1.0, true, false, false };
+    MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+    auto landmark_heuristic = std::make_shared<LandmarkHeuristic<Point>>(std::make_shared<const LandmarkTable>(map, rules, 4), std::make_shared<Diagonal<Point>>());
+    AStar alt{ landmark_heuristic, std::make_shared<GMax>(), options };
+    JumpPoint jump_point{ landmark_heuristic, std::make_shared<GMax>(), options };
+    BOOST_CHECK(alt.search({ 20, 20 }, { 50, 20 }, map).path_found);
+    BOOST_CHECK(jump_point.search({ 20, 20 }, { 50, 20 }, map).path_found);
+
+    // an opened wall makes the stored distances overestimate, so the table must not be used any more
+    BOOST_REQUIRE(map.set_cell(30, 20, CellType::empty));
+    BOOST_CHECK_THROW(alt.search({ 20, 20 }, { 50, 20 }, map), std::logic_error);
+    BOOST_CHECK_THROW(jump_point.search({ 20, 20 }, { 50, 20 }, map), std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,7 @@
 #include <boost/test/unit_test.hpp>
+#include <random>
+#include <type_traits>
+#include <vector>
 #include "../src/map.hpp"
 
 
@@ -6,4 +9,54 @@ using namespace planner;
 
 BOOST_AUTO_TEST_SUITE(map)
 
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+BOOST_AUTO_TEST_CASE(test_neighbourhood) {
+    GridMap<> map{ 3, 3, 1.0, std::vector<int>{
+        0, 1, 0,
+        0, 0, 0,
+        1, 0, 0,
+    }, InverseMapper{} };
+    // directions: (-1, -1), (-1, 0), (-1, 1), (0, 1), (1, 1), (1, 0), (1, -1), (0, -1)
+    BOOST_CHECK_EQUAL(map.neighbourhood(1, 1), 0b01111011);
+    BOOST_CHECK_EQUAL(map.neighbourhood(0, 0), 0b00011000);
+    BOOST_CHECK_EQUAL(map.neighbourhood(2, 2), 0b10000011);
+}
+
+BOOST_AUTO_TEST_CASE(test_set_cell) {
+    std::mt19937 generator{ 3 };
+    std::bernoulli_distribution obstacle{ 0.4 };
+    const size_t width = 9, height = 7;
+    std::vector<int> cells(width * height);
+    for (auto& cell : cells) {
+        cell = obstacle(generator);
+    }
+    GridMap<> map{ width, height, 1.0, cells, InverseMapper{} };
+    std::uniform_int_distribution<size_t> x_distribution{ 0, width - 1 }, y_distribution{ 0, height - 1 };
+    for (size_t change = 0; change < 100; ++change) {
+        size_t x = x_distribution(generator), y = y_distribution(generator);
+        int value = obstacle(generator);
+        auto revision = map.get_revision();
+        bool changed = map.set_cell(x, y, value ? CellType::obstacle : CellType::empty);
+        BOOST_CHECK_EQUAL(changed, cells[y * width + x] != value);
+        BOOST_CHECK_EQUAL(map.get_revision() != revision, changed);
+        cells[y * width + x] = value;
+
+        GridMap<> expected{ width, height, 1.0, cells, InverseMapper{} };
+        BOOST_CHECK_EQUAL(map.fingerprint(), expected.fingerprint());
+        for (size_t cell_y = 0; cell_y < height; ++cell_y) {
+            for (size_t cell_x = 0; cell_x < width; ++cell_x) {
+                BOOST_CHECK_EQUAL(map.neighbourhood(cell_x, cell_y), expected.neighbourhood(cell_x, cell_y));
+            }
+        }
+    }
+
+    auto first = map(0, 0) == CellType::obstacle ? CellType::empty : CellType::obstacle;
+    auto changed = map.set_cells({ { Point{ 0, 0 }, first }, { Point{ 1, 0 }, map(1, 0) } });
+    BOOST_REQUIRE_EQUAL(changed.size(), 1);
+    BOOST_CHECK_EQUAL(changed.front(), (Point{ 0, 0 }));
+
+    // cells can't be written through iterators, which would bypass neighbourhoods and the revision
+    static_assert(std::is_same_v<decltype(*map.begin()), const CellType&>);
+    static_assert(std::is_same_v<decltype(*map.rbegin()), const CellType&>);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,52 @@
+#include <boost/test/unit_test.hpp>
+#include "../src/search/memory.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(memory)
+
+BOOST_AUTO_TEST_CASE(test_records) {
+    GridMemory memory;
+    memory.reset(4);
+    BOOST_CHECK_EQUAL(memory.size(), 4);
+    BOOST_CHECK(!memory.visited(0));
+
+    memory.open(0, 7, 1.5);
+    BOOST_CHECK(memory.visited(0));
+    BOOST_CHECK(!memory.closed(0));
+    BOOST_CHECK_EQUAL(memory[0].node, 7);
+    BOOST_CHECK_EQUAL(memory[0].distance, 1.5);
+
+    memory.relax(0, 1.0);
+    BOOST_CHECK_EQUAL(memory[0].distance, 1.0);
+
+    memory.close(0);
+    BOOST_CHECK(memory.visited(0));
+    BOOST_CHECK(memory.closed(0));
+    BOOST_CHECK(!memory.visited(1));
+}
+
+BOOST_AUTO_TEST_CASE(test_reset) {
+    GridMemory memory;
+    memory.reset(4);
+    memory.open(1, 0, 1.0);
+    memory.open(2, 1, 2.0);
+    memory.close(2);
+
+    memory.reset(4);
+    for (size_t cell = 0; cell < memory.size(); ++cell) {
+        BOOST_CHECK(!memory.visited(cell));
+        BOOST_CHECK(!memory.closed(cell));
+    }
+
+    memory.open(2, 0, 3.0);
+    BOOST_CHECK(memory.visited(2));
+    BOOST_CHECK(!memory.closed(2));
+
+    memory.reset(9);
+    BOOST_CHECK_EQUAL(memory.size(), 9);
+    BOOST_CHECK(!memory.visited(2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,37 @@
+#include <boost/test/unit_test.hpp>
+#include "../src/search/moves.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(moves)
+
+BOOST_AUTO_TEST_CASE(test_straight_moves) {
+    MoveRules rules{ false, true, true };
+    BOOST_CHECK_EQUAL(rules(0b11111111), 0b10101010);
+    BOOST_CHECK_EQUAL(rules(0b00000001), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_diagonal_moves) {
+    // diagonal (-1, -1) with its components (-1, 0) and (0, -1)
+    std::uint8_t open = 0b10000011;
+    std::uint8_t cut_corner = 0b00000011;
+    std::uint8_t squeeze = 0b00000001;
+    {
+        MoveRules rules{ true, false, false };
+        BOOST_CHECK_EQUAL(rules(open), 0b10000011);
+        BOOST_CHECK_EQUAL(rules(cut_corner), 0b00000010);
+        BOOST_CHECK_EQUAL(rules(squeeze), 0);
+    }
+    {
+        MoveRules rules{ true, true, false };
+        BOOST_CHECK_EQUAL(rules(cut_corner), 0b00000011);
+        BOOST_CHECK_EQUAL(rules(squeeze), 0);
+    }
+    {
+        MoveRules rules{ true, true, true };
+        BOOST_CHECK_EQUAL(rules(squeeze), 0b00000001);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
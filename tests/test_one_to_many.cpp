@@ -0,0 +1,83 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(one_to_many)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    for_random_maps(53, { 4, 30, 25, 0.3, 0 }, move_options(), [](std::mt19937& generator, const GridMap<>& map, const Options& options) {
+        std::uniform_int_distribution<size_t> x_distribution{ 0, map.get_width() - 1 }, y_distribution{ 0, map.get_height() - 1 };
+        AStar astar{ grid_heuristic(options), std::make_shared<GMax>(), options };
+        MoveRules rules{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+        Point from{ x_distribution(generator), y_distribution(generator) };
+        while (map(from.x, from.y) == CellType::obstacle) {
+            from = { x_distribution(generator), y_distribution(generator) };
+        }
+        std::vector<Point> targets;
+        for (size_t target = 0; target < 20; ++target) {
+            targets.push_back({ x_distribution(generator), y_distribution(generator) });
+        }
+        auto result = astar.search_many(from, targets, map);
+        BOOST_CHECK_EQUAL(result.distances.size(), targets.size());
+        for (size_t target = 0; target < targets.size(); ++target) {
+            const Point& to = targets[target];
+            BOOST_TEST_CONTEXT(from << " -> " << to) {
+                bool free = map(to.x, to.y) != CellType::obstacle;
+                auto expected = reference_search(from, to, map, options);
+                BOOST_REQUIRE_EQUAL(result.found(target), free && expected.path_found);
+                if (!result.found(target)) {
+                    BOOST_CHECK(result.path(target).empty());
+                    continue;
+                }
+                BOOST_CHECK_CLOSE(result.distances[target] + 1.0, expected.path_length() + 1.0, 1e-9);
+                auto path = result.path(target);
+                BOOST_CHECK_EQUAL(path.front(), from);
+                BOOST_CHECK_EQUAL(path.back(), to);
+                double length = 0;
+                for (size_t i = 1; i < path.size(); ++i) {
+                    std::size_t direction = direction_between(path[i - 1], path[i]);
+                    BOOST_CHECK(rules(map.neighbourhood(path[i - 1].x, path[i - 1].y)) & (1u << direction));
+                    length += MoveRules::cost(direction);
+                }
+                BOOST_CHECK_CLOSE(length + 1.0, result.distances[target] + 1.0, 1e-9);
+            }
+        }
+        BOOST_CHECK(std::is_sorted(std::begin(result.order), std::end(result.order), [&](size_t a, size_t b) {
+            return result.distances[a] < result.distances[b];
+        }));
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_nearest) {
+    GridMap<> map{ 20, 20, 1.0, std::vector<int>(20 * 20, 0), InverseMapper{} };
+    AStar astar{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), Options{ 1.0, true, true, false } };
+    std::vector<Point> targets = { { 19, 19 }, { 3, 2 }, { 10, 0 }, { 1, 1 }, { 3, 2 }, { 25, 0 } };
+    auto all = astar.search_many({ 0, 0 }, targets, map);
+    BOOST_CHECK_EQUAL(all.order.size(), 5u);
+    BOOST_CHECK(!all.found(5));
+    BOOST_CHECK_EQUAL(all.order.front(), 3u);
+    BOOST_CHECK_EQUAL(all.order.back(), 0u);
+    BOOST_CHECK_EQUAL(all.distances[1], all.distances[4]);
+
+    auto nearest = astar.search_many({ 0, 0 }, targets, map, 2);
+    BOOST_CHECK_EQUAL(nearest.order.size(), 3u);  // both targets on the same cell are found together
+    BOOST_CHECK(nearest.found(3) && nearest.found(1) && nearest.found(4));
+    BOOST_CHECK(!nearest.found(0) && !nearest.found(2));
+    BOOST_CHECK_EQUAL(nearest.distances[1], all.distances[1]);
+    BOOST_CHECK_LT(nearest.expanded, all.expanded);
+    BOOST_CHECK(nearest.path(0).empty());
+    BOOST_CHECK_EQUAL(nearest.path(3).size(), 2u);
+
+    auto none = astar.search_many({ 0, 0 }, {}, map);
+    BOOST_CHECK(none.order.empty());
+    BOOST_CHECK_EQUAL(none.expanded, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
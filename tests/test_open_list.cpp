@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include "../src/search/bucket_queue.hpp"
+#include "../src/search/open_list.hpp"
+
+
+using namespace planner;
+
+namespace {
+    struct PriorityComparator {
+        const std::vector<int>& priorities;
+
+        bool operator () (size_t a, size_t b) const {
+            return priorities[a] < priorities[b];
+        }
+    };
+
+    template <template <typename, typename> class OpenList>
+    void check_ordering() {
+        std::vector<int> priorities = { 17, 13, 19, 11, 15, 18, 12, 16, 14, 10 };
+        OpenList<size_t, PriorityComparator> open{ PriorityComparator{ priorities }, priorities.size() };
+        for (size_t key = 0; key < priorities.size(); ++key) {
+            open.push(key, key);
+        }
+        BOOST_CHECK_EQUAL(open.size(), priorities.size());
+        BOOST_CHECK(open.contains(2));
+        BOOST_CHECK_EQUAL(open.at(2), 2);
+        BOOST_CHECK_EQUAL(open.top(), 9);
+
+        open.decrease(2, [&priorities]() { priorities[2] = -1; });
+        open.decrease(0, [&priorities]() { priorities[0] = 9; });
+        BOOST_CHECK_EQUAL(open.top(), 2);
+
+        std::vector<int> popped;
+        while (!open.empty()) {
+            popped.push_back(priorities[open.top()]);
+            open.pop();
+        }
+        std::vector<int> expected = { -1, 9, 10, 11, 12, 13, 14, 15, 16, 18 };
+        BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(popped), std::end(popped), std::begin(expected), std::end(expected));
+        BOOST_CHECK(!open.contains(2));
+
+        open.push(3, 3);
+        open.push(4, 4);
+        open.clear();
+        BOOST_CHECK(open.empty());
+        BOOST_CHECK(!open.contains(3));
+        BOOST_CHECK(!open.contains(4));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(open_list)
+
+BOOST_AUTO_TEST_CASE(test_set) {
+    check_ordering<SetOpenList>();
+}
+
+BOOST_AUTO_TEST_CASE(test_binary_heap) {
+    check_ordering<BinaryHeap>();
+}
+
+BOOST_AUTO_TEST_CASE(test_quaternary_heap) {
+    check_ordering<QuaternaryHeap>();
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_erase) {
+    std::vector<int> priorities = { 17, 13, 19, 11, 15, 18, 12, 16, 14, 10, 20, 9 };
+    QuaternaryHeap<size_t, PriorityComparator> open{ PriorityComparator{ priorities }, priorities.size() };
+    for (size_t key = 0; key < priorities.size(); ++key) {
+        open.push(key, key);
+    }
+    open.erase(11);
+    open.erase(4);
+    open.erase(10);
+    open.erase(4);
+    BOOST_CHECK_EQUAL(open.size(), priorities.size() - 3);
+    BOOST_CHECK(!open.contains(4));
+
+    std::vector<int> popped;
+    while (!open.empty()) {
+        popped.push_back(priorities[open.top()]);
+        open.pop();
+    }
+    std::vector<int> expected = { 10, 11, 12, 13, 14, 16, 17, 18, 19 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(popped), std::end(popped), std::begin(expected), std::end(expected));
+}
+
+BOOST_AUTO_TEST_CASE(test_heap_buffers) {
+    std::vector<int> priorities = { 5, 3, 8, 1, 9, 2 };
+    OpenListBuffers<size_t> buffers;
+    for (size_t round = 0; round < 3; ++round) {
+        QuaternaryHeap<size_t, PriorityComparator> open{ PriorityComparator{ priorities }, priorities.size(), buffers };
+        for (size_t key = 0; key < priorities.size(); ++key) {
+            BOOST_CHECK(!open.contains(key));
+            open.push(key, key);
+        }
+        open.pop();
+        BOOST_CHECK_EQUAL(priorities[open.top()], 2);
+        // the heap is destroyed with values left, the next one must still start empty
+    }
+    BOOST_CHECK(buffers.items.empty());
+    BOOST_CHECK_GE(buffers.items.capacity(), priorities.size());
+    BOOST_CHECK_EQUAL(buffers.slots.size(), priorities.size());
+    for (size_t slot : buffers.slots) {
+        BOOST_CHECK_EQUAL(slot, (QuaternaryHeap<size_t, PriorityComparator>::npos));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_bucket_queue) {
+    // values are keyed by their tens, so every bucket holds several values
+    BucketQueue<int, std::less<>> open;
+    for (int value : { 35, 31, 12, 38, 17, 33, 15 }) {
+        open.push(static_cast<size_t>(value / 10), value);
+    }
+    BOOST_CHECK_EQUAL(open.size(), 7u);
+    BOOST_CHECK_EQUAL(open.values().size(), 7u);
+    int sum = 0;
+    open.for_each([&sum](int value) { sum += value; });
+    BOOST_CHECK_EQUAL(sum, 35 + 31 + 12 + 38 + 17 + 33 + 15);
+    std::vector<int> popped;
+    for (size_t i = 0; i < 3; ++i) {
+        popped.push_back(open.top());
+        open.pop();
+    }
+    // into the current bucket, into a later one and below the current one
+    open.push(3, 32);
+    open.push(5, 50);
+    open.push(0, 7);
+    while (!open.empty()) {
+        popped.push_back(open.top());
+        open.pop();
+    }
+    std::vector<int> expected = { 12, 15, 17, 7, 31, 32, 33, 35, 38, 50 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(popped), std::end(popped), std::begin(expected), std::end(expected));
+
+    open.push(2, 20);
+    open.clear();
+    BOOST_CHECK(open.empty());
+    open.push(4, 41);
+    BOOST_CHECK_EQUAL(open.top(), 41);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(path_database)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    check_random_maps(43, { 5, 30, 25, 0.3, 30 }, move_options(), [](const Options& options) {
+        return std::make_shared<PathDatabaseSearch>(grid_heuristic(options), std::make_shared<GMax>(), options);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_compression) {
+    // an open room: first moves towards cells of a far part of the room are the same, so rows break into few runs
+    GridMap<> map{ 40, 40, 1.0, std::vector<int>(40 * 40, 0), InverseMapper{} };
+    MoveRules rules{ true, true, false };
+    PathDatabase database{ map, rules, 2 };
+    BOOST_CHECK_LT(database.run_count(), 40u * 40u * 40u * 40u / 20u);
+
+    BOOST_CHECK_EQUAL(database.first_move(0, 0), PathDatabase::no_move);
+    BOOST_CHECK_EQUAL(database.first_move(0, 41), 4u);  // (0, 0) -> (1, 1)
+    BOOST_CHECK_EQUAL(database.first_move(41, 0), 0u);  // (1, 1) -> (0, 0)
+
+    std::stringstream stream;
+    database.save(stream, 11);
+    std::string saved = stream.str();
+    std::stringstream input{ saved };
+    auto loaded = PathDatabase::load(input, 11, 1600);
+    BOOST_REQUIRE(loaded.has_value());
+    BOOST_CHECK_EQUAL(loaded->run_count(), database.run_count());
+    for (size_t from = 0; from < 1600; from += 37) {
+        for (size_t to = 0; to < 1600; to += 13) {
+            BOOST_CHECK_EQUAL(loaded->first_move(from, to), database.first_move(from, to));
+        }
+    }
+    std::stringstream other_key{ saved };
+    BOOST_CHECK(!PathDatabase::load(other_key, 12, 1600).has_value());
+    std::stringstream other_size{ saved };
+    BOOST_CHECK(!PathDatabase::load(other_size, 11, 1601).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(test_corrupted_files) {
+    GridMap<> map{ 10, 10, 1.0, std::vector<int>(10 * 10, 0), InverseMapper{} };
+    PathDatabase database{ map, MoveRules{ true, true, false }, 1 };
+    std::stringstream stream;
+    database.save(stream, 7);
+    const std::string saved = stream.str();
+    // header of magic, key and counts, then numbers, components, offsets and runs
+    const std::size_t cells = 100, offsets = 32 + 8 * cells, runs = offsets + 8 * (cells + 1);
+    BOOST_REQUIRE_GT(database.run_count(), cells);
+
+    auto load = [](const std::string& bytes) {
+        std::stringstream input{ bytes };
+        return PathDatabase::load(input, 7, 100);
+    };
+    auto corrupt = [&saved](std::size_t position, auto value) {
+        std::string bytes = saved;
+        std::memcpy(&bytes[position], &value, sizeof(value));
+        return bytes;
+    };
+    auto offset = [&saved](std::size_t cell) {
+        std::uint64_t value = 0;
+        std::memcpy(&value, &saved[offsets + 8 * cell], sizeof(value));
+        return value;
+    };
+    BOOST_REQUIRE(load(saved).has_value());
+
+    BOOST_CHECK(!load(saved.substr(0, saved.size() - 1)).has_value());
+    BOOST_CHECK(!load(corrupt(24, std::uint64_t{ 1 } << 40u)).has_value());
+    BOOST_CHECK(!load(corrupt(24, database.run_count() - 1)).has_value());
+    BOOST_CHECK(!load(corrupt(32, std::uint32_t{ 100 })).has_value());
+    BOOST_CHECK(!load(corrupt(32, PathDatabase::none)).has_value());
+    // empty, reversed and too long rows
+    BOOST_CHECK(!load(corrupt(offsets + 8, offset(0))).has_value());
+    BOOST_CHECK(!load(corrupt(offsets + 8, offset(2) + 1)).has_value());
+    BOOST_CHECK(!load(corrupt(offsets + 8 * 50, database.run_count() + 1)).has_value());
+    // a row must start with target number 0 and keep its runs in order
+    BOOST_CHECK(!load(corrupt(runs, std::uint32_t{ 1u << 3u })).has_value());
+    BOOST_REQUIRE_GT(offset(1), 2u);
+    std::uint32_t second = 0;
+    std::memcpy(&second, &saved[runs + 4], sizeof(second));
+    BOOST_CHECK(!load(corrupt(runs + 8, second)).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(test_separate_areas) {
+    // 0 0 1 0
+    // 0 0 1 0
+    GridMap<> map{ 4, 2, 1.0, std::vector<int>{ 0, 0, 1, 0, 0, 0, 1, 0 }, InverseMapper{} };
+    PathDatabaseSearch cpd{ std::make_shared<Diagonal<Point>>(), std::make_shared<GMax>(), Options{ 1.0, true, true, true } };
+    BOOST_CHECK(!cpd.search({ 0, 0 }, { 3, 1 }, map).path_found);
+    BOOST_CHECK(!cpd.search({ 0, 0 }, { 2, 0 }, map).path_found);
+    auto result = cpd.search({ 1, 1 }, { 1, 1 }, map);
+    BOOST_REQUIRE(result.path_found);
+    BOOST_CHECK_EQUAL(result.path().size(), 1u);
+    BOOST_CHECK_EQUAL(cpd.search({ 3, 0 }, { 3, 1 }, map).path_length(), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -51,4 +51,52 @@ BOOST_AUTO_TEST_CASE(test_evaluation) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_comparison) {
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ 0, 0 }), 0);
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ 3, 0 }), 1);
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ 0, -2 }), -1);
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ 3, -2 }), 1);  // 9 > 8
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ -7, 5 }), 1);  // 49 < 50
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ 114243, -80782 }), 1);  // a close rational approximation of sqrt(2)
+    BOOST_CHECK_EQUAL(exact_sign(Quadratic<int>{ -114243, 80782 }), -1);
+
+    BOOST_CHECK(Quadratic<int>(0, 1) < Quadratic<int>(2, 0));
+    BOOST_CHECK(Quadratic<int>(2, 0) > Quadratic<int>(0, 1));
+    BOOST_CHECK(Quadratic<int>(1, 1) <= Quadratic<int>(1, 1));
+    BOOST_CHECK(Quadratic<int>(1, 1) >= Quadratic<int>(1, 1));
+    BOOST_CHECK(!(Quadratic<int>(1, 1) < Quadratic<int>(1, 1)));
+    BOOST_CHECK(Quadratic<int>(7, 0) < Quadratic<int>(2, 4));  // 7 < 7.65
+    BOOST_CHECK(Quadratic<int>(1, 2) != Quadratic<int>(2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(test_multiplication) {
+    BOOST_CHECK_EQUAL(Quadratic<int>(1, 1) * Quadratic<int>(1, 1), Quadratic<int>(3, 2));
+    BOOST_CHECK_EQUAL(Quadratic<int>(0, 1) * Quadratic<int>(0, 1), Quadratic<int>(2, 0));
+    BOOST_CHECK_EQUAL(Quadratic<int>(3, -2) * Quadratic<int>(3, 2), Quadratic<int>(1, 0));
+    BOOST_CHECK_EQUAL(Quadratic<int>(2, 5) * 3, Quadratic<int>(6, 15));
+}
+
+BOOST_AUTO_TEST_CASE(test_root_sum_comparison) {
+    // sqrt(25) = 5
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{}, 25 }, length{ number{ 5 } }), 0);
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{}, 26 }, length{ number{ 5 } }), 1);
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{}, 24 }, length{ number{ 5 } }), -1);
+    // sqrt(8) = 2 * sqrt(2)
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{}, 8 }, length{ number{ 0, 2 } }), 0);
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ 1 }, 8 }, length{ number{ 1, 2 } }), 0);
+    // 1 + sqrt(13) = 4.6056 < 2 + sqrt(7) = 4.6458
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ 1 }, 13 }, length{ number{ 2 }, 7 }), -1);
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ 2 }, 7 }, length{ number{ 1 }, 13 }), 1);
+    // 3 + sqrt(2) = 4.4142 is less than sqrt(20) = 4.4721 and sqrt(2) + sqrt(10) = 4.5765
+    BOOST_CHECK(length(number{ 3, 1 }) < length(number{}, 20));
+    BOOST_CHECK(length(number{ 3, 1 }) < length(number{ 0, 1 }, 10));
+    BOOST_CHECK(length(number{ 0, 1 }, 10) == length(number{ 0, 1 }, 10));
+    // differences far below double precision: 114243 - 80782 * sqrt(2) is about 3.8e-11
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ 0, 80782 } }, length{ number{ 114243 } }), -1);
+    // squares of squares exceed 64 bits
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ -212, -381 }, 32507 }, length{ number{ 25, -481 }, 20905 }), -1);
+    BOOST_CHECK_EQUAL(exact_compare(length{ number{ 7000, 3000 }, 150000000 }, length{ number{ 6000, 3500 }, 160000000 }), -1);
+    BOOST_CHECK_CLOSE(evaluate(length{ number{ 1, 1 }, 9 }), 4 + sqrt(2), 1e-9);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
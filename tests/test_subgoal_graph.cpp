@@ -0,0 +1,45 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(subgoal_graph)
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    check_random_maps(47, { 15, 40, 30, 0.3, 20 }, move_options(), [](const Options& options) {
+        return std::make_shared<SubgoalGraphSearch>(grid_heuristic(options), std::make_shared<GMax>(), options);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(test_corners) {
+    // 0 0 0 0 0
+    // 0 0 0 0 0
+    // 0 0 1 0 0
+    // 0 0 0 0 0
+    // 0 0 0 0 0
+    std::vector<int> cells(25, 0);
+    cells[12] = 1;
+    GridMap<> map{ 5, 5, 1.0, cells, InverseMapper{} };
+
+    // paths turn at the diagonal neighbours of the obstacle, when corners can't be cut
+    SubgoalGraph graph{ map, MoveRules{ true, false, false }, true };
+    BOOST_CHECK_EQUAL(graph.subgoal_count(), 4u);
+    for (size_t cell : { 6, 8, 16, 18 }) {
+        BOOST_CHECK_NE(graph.number(cell), SubgoalGraph::none);
+    }
+    BOOST_CHECK_EQUAL(graph.subgoal(graph.number(6)).edges.size(), 2u);  // opposite corners are not h-reachable
+
+    // and at its straight neighbours otherwise
+    SubgoalGraph cutting{ map, MoveRules{ true, true, false }, true };
+    BOOST_CHECK_EQUAL(cutting.subgoal_count(), 4u);
+    for (size_t cell : { 7, 11, 13, 17 }) {
+        BOOST_CHECK_NE(cutting.number(cell), SubgoalGraph::none);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "common.hpp"
+#include "../src/search/search.hpp"
+
+
+using namespace planner;
+
+BOOST_AUTO_TEST_SUITE(theta_star)
+
+BOOST_AUTO_TEST_CASE(test_line_of_sight) {
+    // 0 0 0 0 0
+    // 0 0 1 0 0
+    // 0 1 0 0 0
+    GridMap<> map{ 5, 3, 1.0, std::vector<int>{ 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 }, InverseMapper{} };
+    LineOfSight strict{ true, false, false };
+    LineOfSight squeezing{ true, true, true };
+    BOOST_CHECK(strict(map, { 0, 0 }, { 4, 0 }));
+    BOOST_CHECK(strict(map, { 2, 0 }, { 4, 1 }));
+    BOOST_CHECK(!strict(map, { 0, 0 }, { 4, 1 }));
+    BOOST_CHECK(!strict(map, { 0, 1 }, { 4, 1 }));
+    BOOST_CHECK(!strict(map, { 0, 0 }, { 2, 2 }));
+    BOOST_CHECK(strict(map, { 3, 0 }, { 4, 2 }));
+    // passes through the corner between (1, 2) and (2, 1)
+    BOOST_CHECK(!strict(map, { 1, 1 }, { 2, 2 }));
+    BOOST_CHECK(squeezing(map, { 1, 1 }, { 2, 2 }));
+    BOOST_CHECK(squeezing(map, { 2, 2 }, { 1, 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(test_random_maps) {
+    std::vector<Options> options_list = {
+        { 1.0, true, false, false },
+        { 1.0, true, true, true },
+    };
+    // neither of them guarantees paths shorter than grid paths, lazy visibility checks lose more
+    auto check_any_angle = [](double tolerance, size_t& checks) {
+        return [tolerance, &checks](const SearchState& result, Point from, Point to, const GridMap<>& map, const Options& options) {
+            AStar astar{ std::make_shared<Euclidean<Point>>(), std::make_shared<GMax>(), options };
+            LineOfSight line_of_sight{ options.allow_diagonal, options.cut_corners, options.allow_squeeze };
+            auto expected = astar.search(from, to, map);
+            BOOST_REQUIRE_EQUAL(result.path_found, expected.path_found);
+            BOOST_CHECK_LE(result.path_length(), expected.path_length() * tolerance + 1e-9);
+            auto path = result.path();
+            for (size_t i = 1; i < path.size(); ++i) {
+                BOOST_CHECK(line_of_sight(map, path[i - 1].position, path[i].position));
+            }
+            checks += static_cast<size_t>(result.statistics.at("lineofsightchecks"));
+        };
+    };
+    size_t theta_checks = 0, lazy_checks = 0;
+    check_random_maps(7, { 30, 24, 17, 0.25, 10 }, options_list, [](const Options& options) {
+        return std::make_shared<ThetaStar>(std::make_shared<Euclidean<Point>>(), std::make_shared<GMax>(), options);
+    }, check_any_angle(1.02, theta_checks));
+    check_random_maps(7, { 30, 24, 17, 0.25, 10 }, options_list, [](const Options& options) {
+        return std::make_shared<LazyThetaStar>(std::make_shared<Euclidean<Point>>(), std::make_shared<GMax>(), options);
+    }, check_any_angle(1.1, lazy_checks));
+    BOOST_CHECK_LT(lazy_checks * 2, theta_checks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()